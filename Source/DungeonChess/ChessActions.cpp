@@ -0,0 +1,141 @@
+// ChessActions.cpp
+#include "ChessActions.h"
+#include "ChessUndo.h"
+
+FString FChessAction::ToString() const
+{
+    switch (Type)
+    {
+    case EChessActionType::Move:    return FString::Printf(TEXT("move %d (%d,%d)"), PieceIndex, Target.X, Target.Y);
+    case EChessActionType::Capture: return FString::Printf(TEXT("capture %d (%d,%d)"), PieceIndex, Target.X, Target.Y);
+    case EChessActionType::Clash:   return FString::Printf(TEXT("clash %d -> %d"), PieceIndex, TargetIndex);
+    case EChessActionType::Eat:     return FString::Printf(TEXT("eat %d (%d,%d)"), PieceIndex, Target.X, Target.Y);
+    default:                        return TEXT("pass");
+    }
+}
+
+void FChessActions::GeneratePlayerActions(const FChessGameState& State, TArray<FChessAction>& OutActions)
+{
+    OutActions.Reset();
+
+    const FChessPieceState& Player = State.Pieces[State.PlayerIndex];
+    if (Player.bAlive)
+    {
+        FChessTileList Tiles;
+
+        // Clash with any enemy in attack range
+        FChessRules::GatherAttackTiles(State.Occupancy, *State.Tables, Player, Tiles);
+        for (const FIntPoint& Tile : Tiles)
+        {
+            FChessAction& Action = OutActions.AddDefaulted_GetRef();
+            Action.Type = EChessActionType::Clash;
+            Action.PieceIndex = State.PlayerIndex;
+            Action.TargetIndex = State.GetPieceIndexAt(Tile.X, Tile.Y);
+            Action.Target = Tile;
+        }
+
+        // Step, or eat an enemy in super mode
+        FChessRules::GatherValidMoves(State.Occupancy, *State.Tables, Player, Tiles);
+        for (const FIntPoint& Tile : Tiles)
+        {
+            FChessAction& Action = OutActions.AddDefaulted_GetRef();
+            Action.PieceIndex = State.PlayerIndex;
+            Action.TargetIndex = State.GetPieceIndexAt(Tile.X, Tile.Y);
+            Action.Type = Action.TargetIndex != INDEX_NONE ? EChessActionType::Eat : EChessActionType::Move;
+            Action.Target = Tile;
+        }
+    }
+
+    // Ending the turn without acting is always allowed
+    FChessAction& Pass = OutActions.AddDefaulted_GetRef();
+    Pass.PieceIndex = State.PlayerIndex;
+}
+
+void FChessActions::GenerateEnemyActions(const FChessGameState& State, TArray<FChessAction>& OutActions)
+{
+    OutActions.Reset();
+
+    const FChessPieceState& Player = State.Pieces[State.PlayerIndex];
+    if (Player.bAlive)
+    {
+        FChessTileList Tiles;
+
+        // Any one enemy acts; every living one is eligible, the turn starts with all of them un-acted
+        for (int32 PieceIndex = 0; PieceIndex < State.Pieces.Num(); PieceIndex++)
+        {
+            const FChessPieceState& Enemy = State.Pieces[PieceIndex];
+            if (PieceIndex == State.PlayerIndex || !Enemy.bAlive || Enemy.bPlayerTeam || Enemy.bHasActedThisTurn)
+            {
+                continue;
+            }
+
+            // Enemies always capture when they can, exactly like the greedy policy
+            if (FChessRules::CanAttackSquare(State.Occupancy, *State.Tables, Enemy, Player.X, Player.Y))
+            {
+                FChessAction& Action = OutActions.AddDefaulted_GetRef();
+                Action.Type = EChessActionType::Capture;
+                Action.PieceIndex = PieceIndex;
+                Action.Target = FIntPoint(Player.X, Player.Y);
+                continue;
+            }
+
+            FChessRules::GatherValidMoves(State.Occupancy, *State.Tables, Enemy, Tiles);
+            for (const FIntPoint& Tile : Tiles)
+            {
+                FChessAction& Action = OutActions.AddDefaulted_GetRef();
+                Action.Type = EChessActionType::Move;
+                Action.PieceIndex = PieceIndex;
+                Action.Target = Tile;
+            }
+        }
+    }
+
+    // No enemy can act: the phase passes and the player's next turn starts
+    if (OutActions.Num() == 0)
+    {
+        OutActions.AddDefaulted();
+    }
+}
+
+bool FChessActions::MakeAction(FChessGameState& State, FChessUndoStack& Undo, const FChessAction& Action, bool bEnemyToMove)
+{
+    Undo.Push(State);
+
+    switch (Action.Type)
+    {
+    case EChessActionType::Move:
+        Undo.SaveAction(State, Action.PieceIndex, Action.Target.X, Action.Target.Y);
+        FChessRules::ApplyMove(State, Action.PieceIndex, Action.Target.X, Action.Target.Y);
+        break;
+
+    case EChessActionType::Capture:
+        Undo.SaveAction(State, Action.PieceIndex, Action.Target.X, Action.Target.Y);
+        FChessRules::ApplyJumpAttack(State, Action.PieceIndex, Action.Target.X, Action.Target.Y);
+        break;
+
+    case EChessActionType::Clash:
+        Undo.SavePiece(State, Action.PieceIndex);
+        Undo.SavePiece(State, Action.TargetIndex);
+        FChessRules::ApplyClash(State, Action.PieceIndex, Action.TargetIndex);
+        break;
+
+    case EChessActionType::Eat:
+        Undo.SaveAction(State, Action.PieceIndex, Action.Target.X, Action.Target.Y);
+        FChessRules::ApplyPlayerEat(State, Action.Target.X, Action.Target.Y);
+        break;
+
+    default:
+        break;
+    }
+
+    // After the enemy phase, or an ExtraMove pickup skipping it, the player's next turn begins
+    if (bEnemyToMove || State.bSkipEnemyTurn)
+    {
+        State.bSkipEnemyTurn = false;
+        Undo.SaveTurnStart(State);
+        FChessRules::StartTurn(State);
+        return false;
+    }
+
+    return true;
+}
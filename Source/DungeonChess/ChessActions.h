@@ -0,0 +1,53 @@
+// ChessActions.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessRules.h"
+
+class FChessUndoStack;
+
+enum class EChessActionType : uint8
+{
+    Pass,
+    Move,       // Player step or enemy move (ApplyMove)
+    Capture,    // Enemy jump attack on the player
+    Clash,      // Player AttackPiece
+    Eat         // Player super mode jump attack
+};
+
+// One action of either side, as the turn rules allow it
+struct FChessAction
+{
+    EChessActionType Type = EChessActionType::Pass;
+    int32 PieceIndex = INDEX_NONE;
+    int32 TargetIndex = INDEX_NONE;
+    FIntPoint Target = FIntPoint(-1, -1);
+
+    // Move ordering hint for searches; the generators leave it at 0
+    int32 OrderScore = 0;
+
+    bool operator==(const FChessAction& Other) const
+    {
+        return Type == Other.Type && PieceIndex == Other.PieceIndex && Target == Other.Target;
+    }
+
+    FString ToString() const;
+};
+
+/**
+ * The DungeonChess turn rules as action lists plus make/unmake, shared by everything that
+ * walks the game tree (FChessEnemySearch, FChessPerft). The player steps, clashes, eats in
+ * super mode or passes, going again after an ExtraMove pickup; then any one enemy acts,
+ * capturing the player whenever it can. A side with nothing to do passes, so the lists are
+ * never empty.
+ */
+class DUNGEONCHESS_API FChessActions
+{
+public:
+    static void GeneratePlayerActions(const FChessGameState& State, TArray<FChessAction>& OutActions);
+    static void GenerateEnemyActions(const FChessGameState& State, TArray<FChessAction>& OutActions);
+
+    // Pushes an undo record, applies Action and returns whether the enemies move next.
+    // Every call must be matched by Undo.Pop.
+    static bool MakeAction(FChessGameState& State, FChessUndoStack& Undo, const FChessAction& Action, bool bEnemyToMove);
+};
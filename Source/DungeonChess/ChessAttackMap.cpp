@@ -0,0 +1,103 @@
+// ChessAttackMap.cpp
+#include "ChessAttackMap.h"
+
+void FChessAttackMap::Init(int32 InNumSquares)
+{
+    NumSquares = FMath::Max(InNumSquares, 0);
+    Sources.Reset();
+    FreeSlots.Reset();
+    Counts.Init(0, NumSquares);
+    ChangedSquares.Init(NumSquares);
+}
+
+void FChessAttackMap::Reset()
+{
+    // Every currently attacked square is about to drop to zero
+    for (int32 Square = 0; Square < NumSquares; Square++)
+    {
+        if (Counts[Square] > 0)
+        {
+            ChangedSquares.Set(Square);
+            Counts[Square] = 0;
+        }
+    }
+
+    Sources.Reset();
+    FreeSlots.Reset();
+}
+
+int32 FChessAttackMap::AddSource()
+{
+    int32 Slot;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        Slot = Sources.AddDefaulted();
+        Sources[Slot].Mask.Init(NumSquares);
+        Sources[Slot].WatchMask.Init(NumSquares);
+    }
+
+    Sources[Slot].bActive = true;
+    return Slot;
+}
+
+void FChessAttackMap::RemoveSource(int32 Slot)
+{
+    if (!Sources.IsValidIndex(Slot) || !Sources[Slot].bActive)
+    {
+        return;
+    }
+
+    SetCoverage(Slot, TArrayView<const int32>());
+    Sources[Slot].bActive = false;
+    FreeSlots.Add(Slot);
+}
+
+void FChessAttackMap::SetCoverage(int32 Slot, TArrayView<const int32> Squares, TArrayView<const int32> WatchSquares)
+{
+    FSource& Source = Sources[Slot];
+
+    for (int32 Square : Source.Squares)
+    {
+        RemoveCount(Square);
+    }
+    Source.Mask.Reset();
+    Source.WatchMask.Reset();
+    Source.Squares.Reset();
+
+    for (int32 Square : Squares)
+    {
+        if (!Source.Mask.Test(Square))
+        {
+            Source.Mask.Set(Square);
+            Source.Squares.Add(Square);
+            AddCount(Square);
+        }
+        Source.WatchMask.Set(Square);
+    }
+
+    for (int32 Square : WatchSquares)
+    {
+        Source.WatchMask.Set(Square);
+    }
+}
+
+void FChessAttackMap::AddCount(int32 Square)
+{
+    if (Counts[Square]++ == 0)
+    {
+        ChangedSquares.Set(Square);
+    }
+}
+
+void FChessAttackMap::RemoveCount(int32 Square)
+{
+    check(Counts[Square] > 0);
+    if (--Counts[Square] == 0)
+    {
+        ChangedSquares.Set(Square);
+    }
+}
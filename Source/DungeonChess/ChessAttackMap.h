@@ -0,0 +1,92 @@
+// ChessAttackMap.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessBitboard.h"
+
+/**
+ * Per-square attack counts built from a set of attack sources (one per enemy).
+ * Each source remembers the squares it covers and the squares its coverage was
+ * computed from, so when a single piece moves or dies only the sources watching
+ * the changed squares need to be regenerated. Squares whose count crosses zero are collected for the visual layer.
+ */
+class DUNGEONCHESS_API FChessAttackMap
+{
+public:
+    void Init(int32 InNumSquares);
+
+    // Drop all sources and counts
+    void Reset();
+
+    // Allocate a source slot with empty coverage
+    int32 AddSource();
+
+    // Remove a source, releasing its coverage
+    void RemoveSource(int32 Slot);
+
+    // Replace the squares covered by a source (duplicates are ignored). WatchSquares are the
+    // squares the coverage was computed from, besides the covered ones; see ForEachSourceWatching.
+    void SetCoverage(int32 Slot, TArrayView<const int32> Squares, TArrayView<const int32> WatchSquares = TArrayView<const int32>());
+
+    FORCEINLINE bool Covers(int32 Slot, int32 Square) const
+    {
+        return Sources[Slot].Mask.Test(Square);
+    }
+
+    // Calls Func(int32 Slot) for every source whose coverage or watch squares contain Square,
+    // i.e. every source that may be stale once Square changes
+    template <typename FuncType>
+    void ForEachSourceWatching(int32 Square, FuncType&& Func) const
+    {
+        for (int32 Slot = 0; Slot < Sources.Num(); Slot++)
+        {
+            if (Sources[Slot].bActive && Sources[Slot].WatchMask.Test(Square))
+            {
+                Func(Slot);
+            }
+        }
+    }
+
+    FORCEINLINE bool IsAttacked(int32 Square) const
+    {
+        return Counts[Square] > 0;
+    }
+
+    FORCEINLINE int32 GetAttackCount(int32 Square) const
+    {
+        return Counts[Square];
+    }
+
+    FORCEINLINE int32 GetNumSquares() const
+    {
+        return NumSquares;
+    }
+
+    // Calls Func(int32 Square) for every square whose count crossed zero since the last call
+    template <typename FuncType>
+    void ConsumeChangedSquares(FuncType&& Func)
+    {
+        ChangedSquares.ForEachSetBit(Func);
+        ChangedSquares.Reset();
+    }
+
+private:
+    struct FSource
+    {
+        FChessBitboard Mask;
+        TArray<int32> Squares;
+
+        // Mask plus the watch squares
+        FChessBitboard WatchMask;
+        bool bActive = false;
+    };
+
+    void AddCount(int32 Square);
+    void RemoveCount(int32 Square);
+
+    TArray<FSource> Sources;
+    TArray<int32> FreeSlots;
+    TArray<uint16> Counts;
+    FChessBitboard ChangedSquares;
+    int32 NumSquares = 0;
+};
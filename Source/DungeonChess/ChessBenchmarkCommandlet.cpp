@@ -0,0 +1,273 @@
+// ChessBenchmarkCommandlet.cpp
+#include "ChessBenchmarkCommandlet.h"
+#include "ChessRules.h"
+#include "ChessMovement.h"
+#include "ChessAttackMap.h"
+#include "DungeonChess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    // Benchmarked movement patterns; the last one runs the queen through its movement program
+    struct FBenchmarkKind
+    {
+        const TCHAR* Name;
+        EChessPieceKind Kind;
+        bool bProgram;
+    };
+
+    const FBenchmarkKind BenchmarkKinds[] = {
+        { TEXT("Basic"),        EChessPieceKind::Basic,  false },
+        { TEXT("Player"),       EChessPieceKind::Player, false },
+        { TEXT("Rook"),         EChessPieceKind::Rook,   false },
+        { TEXT("Knight"),       EChessPieceKind::Knight, false },
+        { TEXT("Bishop"),       EChessPieceKind::Bishop, false },
+        { TEXT("Queen"),        EChessPieceKind::Queen,  false },
+        { TEXT("QueenProgram"), EChessPieceKind::Queen,  true }
+    };
+
+    const EChessPieceKind EnemyKinds[] = {
+        EChessPieceKind::Basic, EChessPieceKind::Rook, EChessPieceKind::Knight,
+        EChessPieceKind::Bishop, EChessPieceKind::Queen
+    };
+
+    typedef void (*FGatherFunc)(const FChessOccupancy&, const FChessMoveTables&, const FChessPieceState&, FChessTileList&);
+
+    struct FBenchmarkQuery
+    {
+        const TCHAR* Name;
+        FGatherFunc Gather;
+    };
+
+    const FBenchmarkQuery BenchmarkQueries[] = {
+        { TEXT("ValidMoves"),       &FChessRules::GatherValidMoves },
+        { TEXT("AttackTiles"),      &FChessRules::GatherAttackTiles },
+        { TEXT("AttackRangeTiles"), &FChessRules::GatherAttackRangeTiles }
+    };
+
+    struct FBenchmarkResult
+    {
+        int64 Calls = 0;
+        int64 Tiles = 0;
+        double Seconds = 0.0;
+    };
+
+    // Player in the middle, then enemies of random kinds on random free squares until Density is reached
+    void BuildPosition(FChessGameState& State, int32 Size, float Density, int32 Seed)
+    {
+        State.Init(Size, Size);
+
+        FChessPieceState Player;
+        Player.Kind = EChessPieceKind::Player;
+        Player.bPlayerTeam = true;
+        Player.X = Size / 2;
+        Player.Y = Size / 2;
+        State.AddPiece(Player);
+
+        FRandomStream Random(Seed);
+        const int32 NumSquares = Size * Size;
+        const int32 NumEnemies = FMath::Clamp(FMath::RoundToInt(NumSquares * Density), 0, NumSquares) - 1;
+
+        TArray<int32> FreeSquares;
+        FreeSquares.Reserve(NumSquares);
+        for (int32 Square = 0; Square < NumSquares; Square++)
+        {
+            if (!State.Occupancy.IsOccupied(Square))
+            {
+                FreeSquares.Add(Square);
+            }
+        }
+
+        for (int32 i = 0; i < NumEnemies && FreeSquares.Num() > 0; i++)
+        {
+            const int32 FreeIndex = Random.RandRange(0, FreeSquares.Num() - 1);
+            const int32 Square = FreeSquares[FreeIndex];
+            FreeSquares.RemoveAtSwap(FreeIndex, EAllowShrinking::No);
+            const FIntPoint Coord = State.Occupancy.ToCoord(Square);
+
+            FChessPieceState Enemy;
+            Enemy.Kind = EnemyKinds[Random.RandRange(0, UE_ARRAY_COUNT(EnemyKinds) - 1)];
+            Enemy.X = Coord.X;
+            Enemy.Y = Coord.Y;
+            Enemy.MovementRange = Random.RandRange(1, 3);
+            State.AddPiece(Enemy);
+        }
+    }
+
+    // Generates from every square (occupied or not) until MinSeconds have passed
+    FBenchmarkResult RunQuery(const FChessGameState& State, FChessPieceState Piece, FGatherFunc Gather, double MinSeconds)
+    {
+        FBenchmarkResult Result;
+        FChessTileList Tiles;
+
+        const int32 NumSquares = State.Occupancy.NumSquares();
+        const double StartTime = FPlatformTime::Seconds();
+        do
+        {
+            for (int32 Square = 0; Square < NumSquares; Square++)
+            {
+                const FIntPoint Coord = State.Occupancy.ToCoord(Square);
+                Piece.X = Coord.X;
+                Piece.Y = Coord.Y;
+                Gather(State.Occupancy, *State.Tables, Piece, Tiles);
+                Result.Tiles += Tiles.Num();
+            }
+            Result.Calls += NumSquares;
+            Result.Seconds = FPlatformTime::Seconds() - StartTime;
+        }
+        while (Result.Seconds < MinSeconds);
+
+        return Result;
+    }
+
+    // Full rebuild of the enemy attack map from scratch, like HighlightAllEnemyAttackRanges
+    FBenchmarkResult RunHighlightAll(const FChessGameState& State, double MinSeconds)
+    {
+        FBenchmarkResult Result;
+        FChessAttackMap AttackMap;
+        AttackMap.Init(State.Occupancy.NumSquares());
+
+        FChessTileList Tiles;
+        TArray<int32, TInlineAllocator<64>> Squares;
+
+        const double StartTime = FPlatformTime::Seconds();
+        do
+        {
+            AttackMap.Reset();
+            for (const FChessPieceState& Enemy : State.Pieces)
+            {
+                if (Enemy.bPlayerTeam || !Enemy.bAlive)
+                {
+                    continue;
+                }
+
+                FChessRules::GatherAttackRangeTiles(State.Occupancy, *State.Tables, Enemy, Tiles);
+                Squares.Reset();
+                for (const FIntPoint& Tile : Tiles)
+                {
+                    Squares.Add(State.Occupancy.ToIndex(Tile.X, Tile.Y));
+                }
+                AttackMap.SetCoverage(AttackMap.AddSource(), Squares);
+                Result.Tiles += Tiles.Num();
+                Result.Calls++;
+            }
+
+            // Stands in for the tile highlight pass
+            AttackMap.ConsumeChangedSquares([](int32 Square) {});
+            Result.Seconds = FPlatformTime::Seconds() - StartTime;
+        }
+        while (Result.Seconds < MinSeconds);
+
+        return Result;
+    }
+
+    void AddRow(FString& Csv, const TCHAR* Benchmark, const TCHAR* Kind, int32 Size, float Density, int32 NumPieces, const FBenchmarkResult& Result)
+    {
+        const double NsPerCall = Result.Calls > 0 ? Result.Seconds * 1e9 / Result.Calls : 0.0;
+        const double CallsPerSecond = Result.Seconds > 0.0 ? Result.Calls / Result.Seconds : 0.0;
+
+        Csv += FString::Printf(TEXT("%s,%s,%d,%d,%.3f,%d,%lld,%lld,%.3f,%.1f,%.0f\n"),
+            Benchmark, Kind, Size, Size, Density, NumPieces, Result.Calls, Result.Tiles, Result.Seconds * 1000.0, NsPerCall, CallsPerSecond);
+
+        UE_LOG(LogDungeonChess, Display, TEXT("  %-16s %-12s %2dx%-2d %4.0f%%  %8.1f ns/call  %6.2f tiles/call"),
+            Benchmark, Kind, Size, Size, Density * 100.0f, NsPerCall,
+            Result.Calls > 0 ? static_cast<double>(Result.Tiles) / Result.Calls : 0.0);
+    }
+
+    template <typename T>
+    void ParseList(const FString& Params, const TCHAR* Name, TArray<T>& InOutValues)
+    {
+        FString List;
+        if (!FParse::Value(*Params, Name, List, false))
+        {
+            return;
+        }
+
+        TArray<FString> Items;
+        List.ParseIntoArray(Items, TEXT(","));
+
+        InOutValues.Reset();
+        for (const FString& Item : Items)
+        {
+            T Value;
+            LexFromString(Value, *Item);
+            InOutValues.Add(Value);
+        }
+    }
+}
+
+UChessBenchmarkCommandlet::UChessBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UChessBenchmarkCommandlet::Main(const FString& Params)
+{
+    TArray<int32> Sizes = { 8, 16, 32, 64 };
+    TArray<float> Densities = { 0.1f, 0.25f, 0.5f };
+    float MinMs = 50.0f;
+    int32 Seed = 0;
+    FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"),
+        FString::Printf(TEXT("MoveGen_%s.csv"), *FDateTime::Now().ToString()));
+
+    ParseList(Params, TEXT("Sizes="), Sizes);
+    ParseList(Params, TEXT("Densities="), Densities);
+    FParse::Value(*Params, TEXT("MinMs="), MinMs);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Csv="), CsvPath);
+
+    const double MinSeconds = FMath::Max(MinMs, 0.0f) / 1000.0;
+
+    UE_LOG(LogDungeonChess, Display, TEXT("ChessBenchmark: %d sizes, %d densities, %.0f ms per case, seed %d"),
+        Sizes.Num(), Densities.Num(), MinMs, Seed);
+
+    FString Csv = TEXT("Benchmark,Kind,Width,Height,Density,Pieces,Calls,Tiles,TotalMs,NsPerCall,CallsPerSec\n");
+
+    for (int32 Size : Sizes)
+    {
+        if (Size <= 0)
+        {
+            continue;
+        }
+
+        for (float Density : Densities)
+        {
+            FChessGameState State;
+            BuildPosition(State, Size, FMath::Clamp(Density, 0.0f, 1.0f), Seed);
+            const int32 NumPieces = State.Pieces.Num();
+
+            for (const FBenchmarkKind& Kind : BenchmarkKinds)
+            {
+                // Enemy team for everything but the player kind, so captures target the other side
+                FChessPieceState Piece;
+                Piece.Kind = Kind.Kind;
+                Piece.Movement = Kind.bProgram ? &FChessMovementProgram::GetBuiltIn(Kind.Kind) : nullptr;
+                Piece.bPlayerTeam = Kind.Kind == EChessPieceKind::Player;
+                Piece.MovementRange = 2;
+
+                for (const FBenchmarkQuery& Query : BenchmarkQueries)
+                {
+                    AddRow(Csv, Query.Name, Kind.Name, Size, Density, NumPieces, RunQuery(State, Piece, Query.Gather, MinSeconds));
+                }
+            }
+
+            AddRow(Csv, TEXT("HighlightAll"), TEXT("Enemies"), Size, Density, NumPieces, RunHighlightAll(State, MinSeconds));
+        }
+    }
+
+    if (!FFileHelper::SaveStringToFile(Csv, *CsvPath))
+    {
+        UE_LOG(LogDungeonChess, Error, TEXT("ChessBenchmark: could not write %s"), *CsvPath);
+        return 1;
+    }
+
+    UE_LOG(LogDungeonChess, Display, TEXT("ChessBenchmark: results written to %s"), *CsvPath);
+    return 0;
+}
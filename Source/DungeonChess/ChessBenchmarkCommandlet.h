@@ -0,0 +1,28 @@
+// ChessBenchmarkCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ChessBenchmarkCommandlet.generated.h"
+
+/**
+ * Move generation micro-benchmarks. For every piece kind, board size and piece density,
+ * times GatherValidMoves / GatherAttackTiles / GatherAttackRangeTiles from every square of
+ * a seeded random position, plus a full enemy attack-range rebuild as done by
+ * ATurnBasedGameMode::HighlightAllEnemyAttackRanges (minus the tile material changes).
+ * Results are logged and written as CSV, so runs can be diffed to catch regressions.
+ *
+ * UnrealEditor-Cmd DungeonChess.uproject -run=ChessBenchmark -Csv=Saved/Benchmarks/MoveGen.csv
+ *
+ * Options: -Sizes=8,16,32,64 -Densities=0.1,0.25,0.5 -MinMs= (time per case) -Seed= -Csv=
+ */
+UCLASS()
+class DUNGEONCHESS_API UChessBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UChessBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,95 @@
+// ChessBitboard.cpp
+#include "ChessBitboard.h"
+
+void FChessBitboard::Init(int32 InNumBits)
+{
+    NumBits = FMath::Max(InNumBits, 0);
+    Words.Init(0, (NumBits + 63) / 64);
+}
+
+void FChessBitboard::Reset()
+{
+    FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+}
+
+int32 FChessBitboard::CountSetBits() const
+{
+    int32 Count = 0;
+    for (uint64 Word : Words)
+    {
+        Count += static_cast<int32>(FPlatformMath::CountBits(Word));
+    }
+    return Count;
+}
+
+bool FChessBitboard::IsEmpty() const
+{
+    for (uint64 Word : Words)
+    {
+        if (Word)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+FChessBitboard& FChessBitboard::operator|=(const FChessBitboard& Other)
+{
+    check(Words.Num() == Other.Words.Num());
+    for (int32 i = 0; i < Words.Num(); i++)
+    {
+        Words[i] |= Other.Words[i];
+    }
+    return *this;
+}
+
+FChessBitboard& FChessBitboard::operator&=(const FChessBitboard& Other)
+{
+    check(Words.Num() == Other.Words.Num());
+    for (int32 i = 0; i < Words.Num(); i++)
+    {
+        Words[i] &= Other.Words[i];
+    }
+    return *this;
+}
+
+void FChessOccupancy::Init(int32 InWidth, int32 InHeight)
+{
+    Width = FMath::Max(InWidth, 0);
+    Height = FMath::Max(InHeight, 0);
+
+    const int32 Squares = Width * Height;
+    Player.Init(Squares);
+    Enemy.Init(Squares);
+    All.Init(Squares);
+}
+
+void FChessOccupancy::Reset()
+{
+    Player.Reset();
+    Enemy.Reset();
+    All.Reset();
+}
+
+void FChessOccupancy::Place(int32 Index, bool bPlayerTeam)
+{
+    if (bPlayerTeam)
+    {
+        Player.Set(Index);
+        Enemy.Clear(Index);
+    }
+    else
+    {
+        Enemy.Set(Index);
+        Player.Clear(Index);
+    }
+    All.Set(Index);
+}
+
+void FChessOccupancy::Remove(int32 Index)
+{
+    Player.Clear(Index);
+    Enemy.Clear(Index);
+    All.Clear(Index);
+}
@@ -0,0 +1,115 @@
+// ChessBitboard.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Dynamically sized bitset with one bit per board square.
+ * Square index follows the board's tile layout: Index = X * BoardHeight + Y.
+ * Backed by 64-bit words so boards larger than 8x8 are supported.
+ */
+struct DUNGEONCHESS_API FChessBitboard
+{
+    void Init(int32 InNumBits);
+
+    // Clear every bit, keeping the current size
+    void Reset();
+
+    FORCEINLINE void Set(int32 Index)
+    {
+        Words[Index >> 6] |= (1ull << (Index & 63));
+    }
+
+    FORCEINLINE void Clear(int32 Index)
+    {
+        Words[Index >> 6] &= ~(1ull << (Index & 63));
+    }
+
+    FORCEINLINE bool Test(int32 Index) const
+    {
+        return (Words[Index >> 6] & (1ull << (Index & 63))) != 0;
+    }
+
+    FORCEINLINE int32 Num() const
+    {
+        return NumBits;
+    }
+
+    int32 CountSetBits() const;
+    bool IsEmpty() const;
+
+    FChessBitboard& operator|=(const FChessBitboard& Other);
+    FChessBitboard& operator&=(const FChessBitboard& Other);
+
+    // Calls Func(int32 Index) for every set bit, in ascending index order
+    template <typename FuncType>
+    void ForEachSetBit(FuncType&& Func) const
+    {
+        for (int32 WordIndex = 0; WordIndex < Words.Num(); WordIndex++)
+        {
+            uint64 Word = Words[WordIndex];
+            while (Word)
+            {
+                const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Word));
+                Func((WordIndex << 6) + Bit);
+                Word &= Word - 1;
+            }
+        }
+    }
+
+private:
+    TArray<uint64> Words;
+    int32 NumBits = 0;
+};
+
+/**
+ * Per-team occupancy of a BoardWidth x BoardHeight board.
+ * Kept in sync by AChessBoard::SetPieceAt so move generation can test squares
+ * without touching tile or piece actors.
+ */
+struct DUNGEONCHESS_API FChessOccupancy
+{
+    void Init(int32 InWidth, int32 InHeight);
+    void Reset();
+
+    FORCEINLINE int32 ToIndex(int32 X, int32 Y) const
+    {
+        return X * Height + Y;
+    }
+
+    FORCEINLINE FIntPoint ToCoord(int32 Index) const
+    {
+        return FIntPoint(Index / Height, Index % Height);
+    }
+
+    FORCEINLINE bool IsInside(int32 X, int32 Y) const
+    {
+        return X >= 0 && X < Width && Y >= 0 && Y < Height;
+    }
+
+    FORCEINLINE int32 NumSquares() const
+    {
+        return Width * Height;
+    }
+
+    void Place(int32 Index, bool bPlayerTeam);
+    void Remove(int32 Index);
+
+    FORCEINLINE bool IsOccupied(int32 Index) const
+    {
+        return All.Test(Index);
+    }
+
+    // True if the square holds a piece hostile to the given team
+    FORCEINLINE bool IsOpponentAt(int32 Index, bool bPlayerTeam) const
+    {
+        return bPlayerTeam ? Enemy.Test(Index) : Player.Test(Index);
+    }
+
+    int32 Width = 0;
+    int32 Height = 0;
+
+    FChessBitboard Player;
+    FChessBitboard Enemy;
+    FChessBitboard All;
+};
@@ -2,9 +2,14 @@
 
 
 #include "ChessBoard.h"
+#include "DungeonChess.h"
 #include "ChessTile.h"
+#include "ChessPieceBase.h"
+#include "PowerUp.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "DrawDebugHelpers.h"
+#include "TimerManager.h"
 
 // Sets default values
 AChessBoard::AChessBoard()
@@ -16,6 +21,14 @@ AChessBoard::AChessBoard()
     USceneComponent* Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
     RootComponent = Root;
 
+    // Optional single-draw tile renderer
+    TileInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("TileInstances"));
+    TileInstances->SetupAttachment(RootComponent);
+    TileInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    TileInstances->NumCustomDataFloats = 1;
+
+    InstancedTileMesh = nullptr;
+    InstancedTileMaterial = nullptr;
 }
 
 // Called when the game starts or when spawned
@@ -27,13 +40,52 @@ void AChessBoard::BeginPlay()
 
 void AChessBoard::GenerateBoard()
 {
+    Occupancy.Init(BoardWidth, BoardHeight);
+    MoveTables = FChessMoveTables::Get(BoardWidth, BoardHeight);
+
+    Zobrist = FChessZobrist::Get(BoardWidth * BoardHeight);
+    SquareHashes.Init(0, BoardWidth * BoardHeight);
+    PositionHash = 0;
+
+    TileData.SetNum(BoardWidth * BoardHeight);
+    for (int32 X = 0; X < BoardWidth; X++)
+    {
+        for (int32 Y = 0; Y < BoardHeight; Y++)
+        {
+            FChessTileData& Data = TileData[Occupancy.ToIndex(X, Y)];
+            Data.GridX = X;
+            Data.GridY = Y;
+            Data.OccupyingPiece = nullptr;
+            Data.PowerUp = nullptr;
+            Data.Visual = GetBaseTileVisual(X, Y);
+        }
+    }
+
+    if (!bSpawnTileActors && !bUseInstancedTiles)
+    {
+        UE_LOG(LogDungeonChess, Warning, TEXT("ChessBoard has neither tile actors nor instanced tiles - tiles will be invisible"));
+    }
+
+    GenerateTileActors();
+    GenerateTileInstances();
+}
+
+void AChessBoard::GenerateTileActors()
+{
+    Tiles.Empty();
+
+    if (!bSpawnTileActors)
+    {
+        return;
+    }
+
     if (!TileClass)
     {
-        UE_LOG(LogTemp, Error, TEXT("TileClass not set in ChessBoard!"));
+        UE_LOG(LogDungeonChess, Error, TEXT("TileClass not set in ChessBoard!"));
         return;
     }
 
-    Tiles.Empty();
+    Tiles.SetNumZeroed(BoardWidth * BoardHeight);
 
     for (int32 X = 0; X < BoardWidth; X++)
     {
@@ -55,7 +107,12 @@ void AChessBoard::GenerateBoard()
                 bool bIsLightTile = (X + Y) % 2 == 0;
 
                 // Set the appropriate material
-                if (NewTile->TileMesh)
+                if (NewTile->TileMesh && bUseInstancedTiles)
+                {
+                    // Drawn by TileInstances; keep the mesh only for cursor collision
+                    NewTile->TileMesh->SetHiddenInGame(true);
+                }
+                else if (NewTile->TileMesh)
                 {
                     if (bIsLightTile && NewTile->NormalMaterial)
                     {
@@ -67,13 +124,13 @@ void AChessBoard::GenerateBoard()
                     }
                 }
 
-                Tiles.Add(NewTile);
+                Tiles[Occupancy.ToIndex(X, Y)] = NewTile;
             }
         }
     }
 }
 
-AChessTile* AChessBoard::GetTileAt(int32 X, int32 Y)
+AChessTile* AChessBoard::GetTileAt(int32 X, int32 Y) const
 {
     if (!IsValidPosition(X, Y))
     {
@@ -89,6 +146,17 @@ AChessTile* AChessBoard::GetTileAt(int32 X, int32 Y)
     return nullptr;
 }
 
+const FChessTileData* AChessBoard::GetTileDataAt(int32 X, int32 Y) const
+{
+    if (!IsValidPosition(X, Y))
+    {
+        return nullptr;
+    }
+
+    int32 Index = X * BoardHeight + Y;
+    return TileData.IsValidIndex(Index) ? &TileData[Index] : nullptr;
+}
+
 FVector AChessBoard::GetWorldLocationForTile(int32 X, int32 Y)
 {
     FVector BoardOrigin = GetActorLocation();
@@ -109,7 +177,7 @@ FVector AChessBoard::GetWorldLocationForTile(int32 X, int32 Y)
     return BoardOrigin + FVector(PosX, PosY, 0.0f);
 }
 
-bool AChessBoard::IsValidPosition(int32 X, int32 Y)
+bool AChessBoard::IsValidPosition(int32 X, int32 Y) const
 {
     return X >= 0 && X < BoardWidth && Y >= 0 && Y < BoardHeight;
 }
@@ -136,3 +204,279 @@ bool AChessBoard::IsValidPositionFloat(float X, float Y)
         Y >= 0.0f && Y < static_cast<float>(BoardHeight);
 }
 
+void AChessBoard::SetPieceAt(int32 X, int32 Y, AChessPieceBase* Piece)
+{
+    if (!IsValidPosition(X, Y))
+    {
+        return;
+    }
+
+    const int32 Index = Occupancy.ToIndex(X, Y);
+    TileData[Index].OccupyingPiece = Piece;
+
+    if (Piece)
+    {
+        Occupancy.Place(Index, Piece->IsPlayerTeam());
+    }
+    else
+    {
+        Occupancy.Remove(Index);
+    }
+
+    RefreshSquareHash(X, Y);
+
+    OnSquareChanged.Broadcast(X, Y);
+}
+
+AChessPieceBase* AChessBoard::GetPieceAt(int32 X, int32 Y) const
+{
+    const FChessTileData* Data = GetTileDataAt(X, Y);
+    return Data ? Data->OccupyingPiece.Get() : nullptr;
+}
+
+bool AChessBoard::RegisterPowerUp(APowerUp* PowerUp, int32 X, int32 Y)
+{
+    if (!PowerUp || !IsValidPosition(X, Y))
+    {
+        return false;
+    }
+
+    FChessTileData& Data = TileData[Occupancy.ToIndex(X, Y)];
+    if (Data.PowerUp && Data.PowerUp != PowerUp)
+    {
+        return false;
+    }
+
+    UnregisterPowerUp(PowerUp);
+
+    Data.PowerUp = PowerUp;
+    PowerUp->GridX = X;
+    PowerUp->GridY = Y;
+    PowerUp->OwningBoard = this;
+    RefreshSquareHash(X, Y);
+    return true;
+}
+
+void AChessBoard::UnregisterPowerUp(APowerUp* PowerUp)
+{
+    if (!PowerUp || PowerUp->OwningBoard.Get() != this || !IsValidPosition(PowerUp->GridX, PowerUp->GridY))
+    {
+        return;
+    }
+
+    FChessTileData& Data = TileData[Occupancy.ToIndex(PowerUp->GridX, PowerUp->GridY)];
+    if (Data.PowerUp == PowerUp)
+    {
+        Data.PowerUp = nullptr;
+        RefreshSquareHash(PowerUp->GridX, PowerUp->GridY);
+    }
+
+    PowerUp->OwningBoard = nullptr;
+}
+
+void AChessBoard::RefreshSquareHash(int32 X, int32 Y)
+{
+    if (!Zobrist.IsValid() || !IsValidPosition(X, Y))
+    {
+        return;
+    }
+
+    const int32 Index = Occupancy.ToIndex(X, Y);
+    const FChessTileData& Data = TileData[Index];
+
+    uint64 SquareHash = Data.PowerUp ? Zobrist->HashPowerUp(Data.PowerUp->GetRulesState().Kind, Index) : 0;
+    if (Data.OccupyingPiece)
+    {
+        SquareHash ^= Zobrist->HashPiece(Data.OccupyingPiece->GetRulesState(), Index);
+    }
+
+    PositionHash ^= SquareHashes[Index] ^ SquareHash;
+    SquareHashes[Index] = SquareHash;
+}
+
+APowerUp* AChessBoard::GetPowerUpAt(int32 X, int32 Y) const
+{
+    const FChessTileData* Data = GetTileDataAt(X, Y);
+    return Data ? Data->PowerUp.Get() : nullptr;
+}
+
+bool AChessBoard::TraceTileFromRay(const FVector& RayOrigin, const FVector& RayDirection, FIntPoint& OutTile) const
+{
+    // Intersect with the horizontal plane the tiles sit on
+    const FVector BoardOrigin = GetActorLocation();
+    if (FMath::IsNearlyZero(RayDirection.Z))
+    {
+        return false;
+    }
+
+    const double T = (BoardOrigin.Z - RayOrigin.Z) / RayDirection.Z;
+    if (T < 0.0)
+    {
+        return false;
+    }
+
+    return GetTileFromWorldLocation(RayOrigin + RayDirection * T, OutTile);
+}
+
+bool AChessBoard::GetTileFromWorldLocation(const FVector& WorldLocation, FIntPoint& OutTile) const
+{
+    // Inverse of GetWorldLocationForTile
+    const FVector Local = WorldLocation - GetActorLocation();
+    const float GridX = (Local.X + (BoardWidth * TileSize) * 0.5f) / TileSize;
+    const float GridY = (Local.Y + (BoardHeight * TileSize) * 0.5f) / TileSize;
+
+    OutTile = FIntPoint(FMath::FloorToInt(GridX), FMath::FloorToInt(GridY));
+    return IsValidPosition(OutTile.X, OutTile.Y);
+}
+
+void AChessBoard::GenerateTileInstances()
+{
+    TileInstances->ClearInstances();
+
+    if (!bUseInstancedTiles)
+    {
+        return;
+    }
+
+    if (!InstancedTileMesh)
+    {
+        UE_LOG(LogDungeonChess, Error, TEXT("InstancedTileMesh not set in ChessBoard!"));
+        return;
+    }
+
+    TileInstances->SetStaticMesh(InstancedTileMesh);
+    if (InstancedTileMaterial)
+    {
+        TileInstances->SetMaterial(0, InstancedTileMaterial);
+    }
+
+    // Instance index matches the square index so visuals can be addressed directly
+    const FVector BoardOrigin = GetActorLocation();
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(BoardWidth * BoardHeight);
+    for (int32 X = 0; X < BoardWidth; X++)
+    {
+        for (int32 Y = 0; Y < BoardHeight; Y++)
+        {
+            Transforms.Emplace(FRotator::ZeroRotator, GetWorldLocationForTile(X, Y) - BoardOrigin, InstancedTileScale);
+        }
+    }
+    TileInstances->AddInstances(Transforms, false);
+
+    for (int32 Index = 0; Index < TileData.Num(); Index++)
+    {
+        TileInstances->SetCustomDataValue(Index, 0, static_cast<float>(TileData[Index].Visual), false);
+    }
+    TileInstances->MarkRenderStateDirty();
+}
+
+EChessTileVisual AChessBoard::GetBaseTileVisual(int32 X, int32 Y) const
+{
+    // Checkerboard pattern
+    return (X + Y) % 2 == 0 ? EChessTileVisual::Normal : EChessTileVisual::Dark;
+}
+
+void AChessBoard::HighlightTile(int32 X, int32 Y, bool bIsAttackTile)
+{
+    if (IsValidPosition(X, Y))
+    {
+        SetTileVisual(X, Y, bIsAttackTile ? EChessTileVisual::Attack : EChessTileVisual::Highlighted);
+    }
+}
+
+void AChessBoard::ResetTileHighlight(int32 X, int32 Y)
+{
+    if (IsValidPosition(X, Y))
+    {
+        SetTileVisual(X, Y, GetBaseTileVisual(X, Y));
+    }
+}
+
+void AChessBoard::SetTileVisual(int32 X, int32 Y, EChessTileVisual Visual)
+{
+    const int32 Index = Occupancy.ToIndex(X, Y);
+    if (TileData[Index].Visual == Visual)
+    {
+        return;
+    }
+
+    TileData[Index].Visual = Visual;
+    ApplyTileVisual(Index);
+}
+
+void AChessBoard::ApplyTileVisual(int32 Index)
+{
+    const EChessTileVisual Visual = Index == HoveredIndex ? EChessTileVisual::Hovered : TileData[Index].Visual;
+
+    if (TileInstances->GetInstanceCount() > Index)
+    {
+        TileInstances->SetCustomDataValue(Index, 0, static_cast<float>(Visual), false);
+
+        // Batch every change made this frame into a single render-state update
+        if (!bTileVisualsDirty)
+        {
+            bTileVisualsDirty = true;
+            GetWorldTimerManager().SetTimerForNextTick(this, &AChessBoard::FlushTileVisuals);
+        }
+    }
+    else if (AChessTile* Tile = Tiles.IsValidIndex(Index) ? Tiles[Index] : nullptr)
+    {
+        if (Visual == EChessTileVisual::Hovered)
+        {
+            Tile->Hover();
+        }
+        else if (Visual == EChessTileVisual::Highlighted || Visual == EChessTileVisual::Attack)
+        {
+            Tile->Highlight(Visual == EChessTileVisual::Attack);
+        }
+        else
+        {
+            Tile->ResetHighlight();
+        }
+    }
+}
+
+void AChessBoard::SetHoveredTile(int32 X, int32 Y)
+{
+    if (!IsValidPosition(X, Y))
+    {
+        ClearHoveredTile();
+        return;
+    }
+
+    const int32 Index = Occupancy.ToIndex(X, Y);
+    if (Index == HoveredIndex)
+    {
+        return;
+    }
+
+    const int32 PreviousIndex = HoveredIndex;
+    HoveredIndex = Index;
+
+    if (PreviousIndex != INDEX_NONE)
+    {
+        ApplyTileVisual(PreviousIndex);
+    }
+    ApplyTileVisual(HoveredIndex);
+}
+
+void AChessBoard::ClearHoveredTile()
+{
+    if (HoveredIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    const int32 PreviousIndex = HoveredIndex;
+    HoveredIndex = INDEX_NONE;
+    ApplyTileVisual(PreviousIndex);
+}
+
+void AChessBoard::FlushTileVisuals()
+{
+    if (bTileVisualsDirty)
+    {
+        bTileVisualsDirty = false;
+        TileInstances->MarkRenderStateDirty();
+    }
+}
@@ -4,8 +4,47 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "ChessBitboard.h"
+#include "ChessMoveTables.h"
+#include "ChessZobrist.h"
 #include "ChessBoard.generated.h"
 
+class AChessPieceBase;
+class APowerUp;
+
+// Visual state of a tile. With instanced tiles this is written to per-instance custom data [0]
+UENUM(BlueprintType)
+enum class EChessTileVisual : uint8
+{
+    Normal,
+    Dark,
+    Highlighted,
+    Attack,
+    Hovered
+};
+
+// Plain per-square tile state. This is the authoritative tile model; AChessTile actors are optional visuals.
+USTRUCT()
+struct FChessTileData
+{
+    GENERATED_BODY()
+
+    int32 GridX = 0;
+    int32 GridY = 0;
+
+    UPROPERTY()
+    TObjectPtr<AChessPieceBase> OccupyingPiece = nullptr;
+
+    // Power-up lying on this square, collected by the next piece that moves here
+    UPROPERTY()
+    TObjectPtr<APowerUp> PowerUp = nullptr;
+
+    EChessTileVisual Visual = EChessTileVisual::Normal;
+};
+
+// Broadcast whenever a square's occupant changes
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBoardSquareChanged, int32 /*X*/, int32 /*Y*/);
+
 UCLASS()
 class DUNGEONCHESS_API AChessBoard : public AActor
 {
@@ -26,24 +65,126 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board")
     TSubclassOf<class AChessTile> TileClass;
 
+    // Spawn an AChessTile actor per square. When off, tiles exist only as FChessTileData
+    // (draw them with bUseInstancedTiles).
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board")
+    bool bSpawnTileActors = true;
+
+    // Draw every tile through one instanced mesh instead of a mesh component per tile actor
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board|Rendering")
+    bool bUseInstancedTiles = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board|Rendering", meta = (EditCondition = "bUseInstancedTiles"))
+    UStaticMesh* InstancedTileMesh;
+
+    // Must read PerInstanceCustomData[0] as an EChessTileVisual (0 normal, 1 dark, 2 highlighted, 3 attack, 4 hovered)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board|Rendering", meta = (EditCondition = "bUseInstancedTiles"))
+    UMaterialInterface* InstancedTileMaterial;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Board|Rendering", meta = (EditCondition = "bUseInstancedTiles"))
+    FVector InstancedTileScale = FVector(1.0f);
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    class UInstancedStaticMeshComponent* TileInstances;
 
 protected:
     virtual void BeginPlay() override;
 
 private:
+    // Optional tile actors, indexed like TileData (null entries when not spawned)
     UPROPERTY()
     TArray<class AChessTile*> Tiles;
 
+    // Flat tile array, Index = X * BoardHeight + Y
+    UPROPERTY()
+    TArray<FChessTileData> TileData;
+
+    // Compact per-team occupancy mirror of TileData's OccupyingPiece
+    FChessOccupancy Occupancy;
+
+    // Precomputed ray tables for this board size (shared between boards of equal size)
+    TSharedPtr<const FChessMoveTables> MoveTables;
+
+    // Zobrist hash of the pieces and power-ups on the board, plus each square's current component
+    TSharedPtr<const FChessZobrist> Zobrist;
+    TArray<uint64> SquareHashes;
+    uint64 PositionHash = 0;
+
+    // Whether instance data needs pushing to the renderer
+    bool bTileVisualsDirty = false;
+
+    // Square under the cursor, drawn on top of its stored visual (INDEX_NONE if none)
+    int32 HoveredIndex = INDEX_NONE;
+
     void GenerateBoard();
+    void GenerateTileActors();
+    void GenerateTileInstances();
+
+    EChessTileVisual GetBaseTileVisual(int32 X, int32 Y) const;
+    void SetTileVisual(int32 X, int32 Y, EChessTileVisual Visual);
+    void ApplyTileVisual(int32 Index);
+
+    // Pushes all instance custom data changed this frame in one render-state update
+    void FlushTileVisuals();
 
 public:
-    AChessTile* GetTileAt(int32 X, int32 Y);
+    // Tile actor at (X, Y), or null when tile actors are disabled
+    AChessTile* GetTileAt(int32 X, int32 Y) const;
+
+    const FChessTileData* GetTileDataAt(int32 X, int32 Y) const;
+
+    bool HasTileActors() const { return Tiles.Num() > 0; }
 
     FVector GetWorldLocationForTile(int32 X, int32 Y);
 
     FVector GetWorldLocationForTileFloat(float X, float Y);
 
-    bool IsValidPosition(int32 X, int32 Y);
+    bool IsValidPosition(int32 X, int32 Y) const;
 
     bool IsValidPositionFloat(float X, float Y);
+
+    // Occupancy - all writes must go through SetPieceAt so the bitsets stay in sync
+    void SetPieceAt(int32 X, int32 Y, class AChessPieceBase* Piece);
+    class AChessPieceBase* GetPieceAt(int32 X, int32 Y) const;
+
+    // Fast occupancy queries for move generation (no actor access)
+    FORCEINLINE bool IsOccupied(int32 X, int32 Y) const
+    {
+        return Occupancy.IsOccupied(Occupancy.ToIndex(X, Y));
+    }
+
+    // True if (X, Y) holds a piece hostile to the given team
+    FORCEINLINE bool IsOpponentAt(int32 X, int32 Y, bool bPlayerTeam) const
+    {
+        return Occupancy.IsOpponentAt(Occupancy.ToIndex(X, Y), bPlayerTeam);
+    }
+
+    const FChessOccupancy& GetOccupancy() const { return Occupancy; }
+
+    FOnBoardSquareChanged OnSquareChanged;
+
+    const FChessMoveTables& GetMoveTables() const { return *MoveTables; }
+
+    // Incremental Zobrist hash of pieces and power-ups; matches FChessGameState::Hash of a captured snapshot
+    uint64 GetPositionHash() const { return PositionHash; }
+
+    // Re-hashes a square after its occupant's stats changed (placement and power-ups update it themselves)
+    void RefreshSquareHash(int32 X, int32 Y);
+
+    // Picking against the board plane (no collision): converts a world ray or point to grid coordinates
+    bool TraceTileFromRay(const FVector& RayOrigin, const FVector& RayDirection, FIntPoint& OutTile) const;
+    bool GetTileFromWorldLocation(const FVector& WorldLocation, FIntPoint& OutTile) const;
+
+    // Hover overlay; does not change the tile's stored highlight state
+    void SetHoveredTile(int32 X, int32 Y);
+    void ClearHoveredTile();
+
+    // Grid-indexed power-up registry. Power-ups unregister themselves when destroyed.
+    bool RegisterPowerUp(APowerUp* PowerUp, int32 X, int32 Y);
+    void UnregisterPowerUp(APowerUp* PowerUp);
+    APowerUp* GetPowerUpAt(int32 X, int32 Y) const;
+
+    // Tile highlighting, routed to the tile actor or the instanced renderer
+    void HighlightTile(int32 X, int32 Y, bool bIsAttackTile = false);
+    void ResetTileHighlight(int32 X, int32 Y);
 };
@@ -0,0 +1,25 @@
+// ChessDebugMessages.cpp
+#include "ChessDebugMessages.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarChessOnScreenMessages(
+    TEXT("Chess.OnScreenMessages"),
+    true,
+    TEXT("Mirror gameplay log messages (LogChessPiece, LogChessPowerUp, LogChessInput, LogChessTurn) on screen."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarChessOnScreenVerbosity(
+    TEXT("Chess.OnScreenVerbosity"),
+    ELogVerbosity::Log,
+    TEXT("Most verbose message shown on screen: 3 Warning, 4 Display, 5 Log, 6 Verbose, 7 VeryVerbose."),
+    ECVF_Default);
+
+void DungeonChess::AddOnScreenMessage(ELogVerbosity::Type Verbosity, float Duration, const FColor& Color, const FString& Message)
+{
+    if (GEngine && CVarChessOnScreenMessages.GetValueOnAnyThread()
+        && static_cast<int32>(Verbosity) <= CVarChessOnScreenVerbosity.GetValueOnAnyThread())
+    {
+        GEngine->AddOnScreenDebugMessage(-1, Duration, Color, Message);
+    }
+}
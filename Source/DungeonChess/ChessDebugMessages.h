@@ -0,0 +1,36 @@
+// ChessDebugMessages.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DungeonChess.h"
+
+/**
+ * Gameplay messages. Each goes to one of the LogChess* categories at a verbosity and is
+ * mirrored on screen while Chess.OnScreenMessages is on. Nothing is formatted unless the
+ * category lets that verbosity through, so a suppressed message (e.g. the VeryVerbose
+ * one in AChessPieceBase::Tick) costs one branch, and with NO_LOGGING (Shipping) the
+ * macro compiles to nothing, arguments included.
+ *
+ *     CHESS_MESSAGE(LogChessTurn, Log, 5.0f, FColor::Cyan, TEXT("===== TURN %d ====="), Turn);
+ *
+ * Categories can be raised or lowered at runtime with "Log LogChessPiece Verbose".
+ */
+namespace DungeonChess
+{
+    DUNGEONCHESS_API void AddOnScreenMessage(ELogVerbosity::Type Verbosity, float Duration, const FColor& Color, const FString& Message);
+}
+
+#if NO_LOGGING
+#define CHESS_MESSAGE(CategoryName, Verbosity, Duration, Color, Format, ...) do { } while (0)
+#else
+#define CHESS_MESSAGE(CategoryName, Verbosity, Duration, Color, Format, ...) \
+    do \
+    { \
+        if (UE_LOG_ACTIVE(CategoryName, Verbosity)) \
+        { \
+            const FString ChessMessageText = FString::Printf(Format, ##__VA_ARGS__); \
+            UE_LOG(CategoryName, Verbosity, TEXT("%s"), *ChessMessageText); \
+            DungeonChess::AddOnScreenMessage(ELogVerbosity::Verbosity, Duration, Color, ChessMessageText); \
+        } \
+    } while (0)
+#endif
@@ -0,0 +1,84 @@
+// ChessDistanceMap.cpp
+#include "ChessDistanceMap.h"
+
+void FChessDistanceMap::Build(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Mover, int32 TargetX, int32 TargetY)
+{
+    const int32 NumSquares = Occupancy.NumSquares();
+    Distances.Init(Unreachable, NumSquares);
+
+    if (!Occupancy.IsInside(TargetX, TargetY))
+    {
+        return;
+    }
+
+    // Walk with a phantom copy of the mover; enemy team so it treats the player as hostile
+    FChessPieceState Phantom = Mover;
+    Phantom.bPlayerTeam = false;
+    Phantom.X = TargetX;
+    Phantom.Y = TargetY;
+
+    TArray<int32, TInlineAllocator<64>> Queue;
+    Queue.Reserve(NumSquares);
+
+    // Squares the target could be attacked from are the goal. Attack patterns are symmetric, so
+    // those are the tiles the mover's attacks would look at from the target itself, up to the
+    // first blocker; the attack range is no substitute (it only holds opponents for Basic pieces
+    // and reaches further than the attacks for the queen).
+    FChessTileList Tiles;
+    FChessRules::GatherAttackScanTiles(Occupancy, Tables, Phantom, Tiles);
+    for (const FIntPoint& Tile : Tiles)
+    {
+        const int32 Square = Occupancy.ToIndex(Tile.X, Tile.Y);
+        if (!Occupancy.IsOccupied(Square) && Distances[Square] == Unreachable)
+        {
+            Distances[Square] = 0;
+            Queue.Add(Square);
+        }
+    }
+
+    for (int32 Head = 0; Head < Queue.Num(); Head++)
+    {
+        const int32 Square = Queue[Head];
+        const FIntPoint Coord = Occupancy.ToCoord(Square);
+        Phantom.X = Coord.X;
+        Phantom.Y = Coord.Y;
+
+        FChessRules::GatherValidMoves(Occupancy, Tables, Phantom, Tiles);
+        for (const FIntPoint& Tile : Tiles)
+        {
+            const int32 Next = Occupancy.ToIndex(Tile.X, Tile.Y);
+            if (Distances[Next] == Unreachable)
+            {
+                Distances[Next] = Distances[Square] + 1;
+                Queue.Add(Next);
+            }
+        }
+    }
+}
+
+FChessDistanceMapSet::FChessDistanceMapSet(const FChessGameState& InState)
+    : State(InState)
+{
+}
+
+const FChessDistanceMap& FChessDistanceMapSet::Get(const FChessPieceState& Mover)
+{
+    const TPair<const FChessMovementProgram*, uint32> Key(Mover.Movement, static_cast<uint32>(Mover.Kind)
+        | (static_cast<uint32>(Mover.bSuperModeActive) << 8)
+        | (static_cast<uint32>(FMath::Clamp(Mover.MovementRange, 0, 0xFFFF)) << 16));
+
+    if (const FChessDistanceMap* Found = Maps.Find(Key))
+    {
+        return *Found;
+    }
+
+    // Without a player every square stays unreachable
+    FChessDistanceMap& Map = Maps.Add(Key);
+    if (State.Pieces.IsValidIndex(State.PlayerIndex) && State.Tables.IsValid())
+    {
+        const FChessPieceState& Player = State.Pieces[State.PlayerIndex];
+        Map.Build(State.Occupancy, *State.Tables, Mover, Player.X, Player.Y);
+    }
+
+    return Map;
+}
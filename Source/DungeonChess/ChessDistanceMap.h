@@ -0,0 +1,48 @@
+// ChessDistanceMap.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessRules.h"
+
+/**
+ * Breadth-first move counts toward a target square for one movement pattern.
+ * Distance 0 marks the empty squares from which a piece of that pattern could
+ * attack the target; every other square holds the number of moves needed to
+ * reach such a square, following the piece's real moves around blockers.
+ *
+ * All built-in move patterns are symmetric, so the search expands squares with
+ * the piece's own moves instead of needing reverse move generation. Custom
+ * UChessMovementDefinition patterns are expected to be symmetric too.
+ */
+class DUNGEONCHESS_API FChessDistanceMap
+{
+public:
+    static constexpr int32 Unreachable = MAX_int32;
+
+    // Mover supplies Kind, Movement, MovementRange and bSuperModeActive; its position is ignored
+    void Build(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Mover, int32 TargetX, int32 TargetY);
+
+    FORCEINLINE int32 GetDistance(int32 Square) const
+    {
+        return Distances.IsValidIndex(Square) ? Distances[Square] : Unreachable;
+    }
+
+private:
+    TArray<int32> Distances;
+};
+
+/**
+ * Distance maps toward the player for one enemy phase, built lazily and shared by all
+ * enemies with the same movement pattern (kind or custom program, movement range and super mode).
+ */
+class DUNGEONCHESS_API FChessDistanceMapSet
+{
+public:
+    explicit FChessDistanceMapSet(const FChessGameState& InState);
+
+    const FChessDistanceMap& Get(const FChessPieceState& Mover);
+
+private:
+    const FChessGameState& State;
+    TMap<TPair<const FChessMovementProgram*, uint32>, FChessDistanceMap> Maps;
+};
@@ -0,0 +1,399 @@
+// ChessEnemySearch.cpp
+#include "ChessEnemySearch.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    const int32 WinScore = 1000000;
+    const int32 InfiniteScore = WinScore + 1000;
+
+    // Scores this close to WinScore are wins or losses a number of plies away
+    const int32 MaxMatePly = 500;
+
+    // Only look at the clock every so many nodes
+    const int64 TimeCheckInterval = 1024;
+
+    int32 ChebyshevDistance(int32 AX, int32 AY, int32 BX, int32 BY)
+    {
+        return FMath::Max(FMath::Abs(AX - BX), FMath::Abs(AY - BY));
+    }
+}
+
+FChessEnemySearch::FChessEnemySearch(const FChessSearchSettings& InSettings)
+    : Settings(InSettings)
+{
+    const int32 SizeLog2 = FMath::Clamp(Settings.TranspositionTableSizeLog2, 8, 24);
+    Table.SetNum(1 << SizeLog2);
+    TableMask = (1ull << SizeLog2) - 1;
+}
+
+FChessSearchResult FChessEnemySearch::FindBestAction(const FChessGameState& State)
+{
+    FChessSearchResult Result;
+
+    const double StartTime = FPlatformTime::Seconds();
+    Deadline = StartTime + Settings.TimeBudgetSeconds;
+    bAborted = false;
+    Nodes = 0;
+
+    if (!State.Tables.IsValid() || !State.Zobrist.IsValid() || !State.Pieces.IsValidIndex(State.PlayerIndex) || State.Outcome != EChessOutcome::None)
+    {
+        return Result;
+    }
+
+    TArray<FChessAction> RootActions;
+    GenerateActions(State, true, RootActions);
+    if (RootActions[0].Type == EChessActionType::Pass)
+    {
+        return Result;
+    }
+
+    FChessAction BestAction = RootActions[0];
+    const int32 MaxDepth = FMath::Max(Settings.MaxDepth, 1);
+
+    // One working copy for the whole search; every node makes and unmakes on it
+    FChessGameState Work = State;
+    Undo.Reset();
+    PlyActions.SetNum(MaxDepth + 2);
+
+    for (int32 Depth = 1; Depth <= MaxDepth; Depth++)
+    {
+        // Previous iteration's best goes first, the rest by the static ordering
+        OrderActions(RootActions, &BestAction);
+
+        FChessAction IterationBest = RootActions[0];
+        int32 Alpha = -InfiniteScore;
+        const int32 Beta = InfiniteScore;
+
+        for (const FChessAction& Action : RootActions)
+        {
+            const bool bEnemyNext = FChessActions::MakeAction(Work, Undo, Action, true);
+            const int32 Score = Search(Work, Depth - 1, Alpha, Beta, bEnemyNext, 1);
+            Undo.Pop(Work);
+
+            if (bAborted)
+            {
+                break;
+            }
+
+            if (Score > Alpha)
+            {
+                Alpha = Score;
+                IterationBest = Action;
+            }
+        }
+
+        // An interrupted iteration is discarded
+        if (bAborted)
+        {
+            break;
+        }
+
+        BestAction = IterationBest;
+        Result.Score = Alpha;
+        Result.CompletedDepth = Depth;
+
+        // Forced win found, deeper search won't change it
+        if (Alpha >= WinScore - Depth)
+        {
+            break;
+        }
+    }
+
+    Result.bFoundAction = true;
+    Result.Action.PieceIndex = BestAction.PieceIndex;
+    Result.Action.Target = BestAction.Target;
+    Result.Action.bAttack = BestAction.Type == EChessActionType::Capture;
+    Result.NodesSearched = Nodes;
+    Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    return Result;
+}
+
+int32 FChessEnemySearch::Search(FChessGameState& State, int32 Depth, int32 Alpha, int32 Beta, bool bEnemyToMove, int32 Ply)
+{
+    if (IsOutOfTime())
+    {
+        return 0;
+    }
+
+    Nodes++;
+
+    if (State.Outcome != EChessOutcome::None || Depth <= 0)
+    {
+        return Evaluate(State, Ply);
+    }
+
+    const int32 OriginalAlpha = Alpha;
+    const int32 OriginalBeta = Beta;
+
+    const uint64 Key = HashState(State, bEnemyToMove);
+    const uint64 StatsKey = HashExactStats(State);
+    FTableEntry& Entry = Table[Key & TableMask];
+    const FChessAction* TableAction = nullptr;
+
+    if (Entry.Key == Key)
+    {
+        // Same layout is still a fine ordering hint even when the stats differ
+        TableAction = &Entry.BestAction;
+
+        if (Entry.StatsKey == StatsKey && Entry.Depth >= Depth)
+        {
+            const int32 EntryScore = FromTableScore(Entry.Score, Ply);
+            if (Entry.Bound == EBoundType::Exact)
+            {
+                return EntryScore;
+            }
+            if (Entry.Bound == EBoundType::Lower)
+            {
+                Alpha = FMath::Max(Alpha, EntryScore);
+            }
+            else
+            {
+                Beta = FMath::Min(Beta, EntryScore);
+            }
+            if (Alpha >= Beta)
+            {
+                return EntryScore;
+            }
+        }
+    }
+
+    TArray<FChessAction>& Actions = PlyActions[Ply];
+    GenerateActions(State, bEnemyToMove, Actions);
+    OrderActions(Actions, TableAction);
+
+    int32 BestScore = bEnemyToMove ? -InfiniteScore : InfiniteScore;
+    FChessAction BestAction = Actions[0];
+
+    for (const FChessAction& Action : Actions)
+    {
+        const bool bEnemyNext = FChessActions::MakeAction(State, Undo, Action, bEnemyToMove);
+        const int32 Score = Search(State, Depth - 1, Alpha, Beta, bEnemyNext, Ply + 1);
+        Undo.Pop(State);
+
+        if (bAborted)
+        {
+            return 0;
+        }
+
+        if (bEnemyToMove)
+        {
+            if (Score > BestScore)
+            {
+                BestScore = Score;
+                BestAction = Action;
+            }
+            Alpha = FMath::Max(Alpha, Score);
+        }
+        else
+        {
+            if (Score < BestScore)
+            {
+                BestScore = Score;
+                BestAction = Action;
+            }
+            Beta = FMath::Min(Beta, Score);
+        }
+
+        if (Alpha >= Beta)
+        {
+            break;
+        }
+    }
+
+    // Replace when at least as deep as what's stored
+    if (Entry.Key != Key || Depth >= Entry.Depth)
+    {
+        Entry.Key = Key;
+        Entry.StatsKey = StatsKey;
+        Entry.Score = ToTableScore(BestScore, Ply);
+        Entry.Depth = static_cast<int16>(Depth);
+        Entry.BestAction = BestAction;
+        Entry.Bound = BestScore <= OriginalAlpha ? EBoundType::Upper
+            : BestScore >= OriginalBeta ? EBoundType::Lower
+            : EBoundType::Exact;
+    }
+
+    return BestScore;
+}
+
+void FChessEnemySearch::GenerateActions(const FChessGameState& State, bool bEnemyToMove, TArray<FChessAction>& OutActions) const
+{
+    const FChessPieceState& Player = State.Pieces[State.PlayerIndex];
+
+    if (bEnemyToMove)
+    {
+        FChessActions::GenerateEnemyActions(State, OutActions);
+    }
+    else
+    {
+        FChessActions::GeneratePlayerActions(State, OutActions);
+    }
+
+    for (FChessAction& Action : OutActions)
+    {
+        switch (Action.Type)
+        {
+        case EChessActionType::Capture:
+            Action.OrderScore = 1000000;
+            break;
+        case EChessActionType::Eat:
+            Action.OrderScore = 200000;
+            break;
+        case EChessActionType::Clash:
+            Action.OrderScore = 100000 + State.Pieces[Action.TargetIndex].AttackPower;
+            break;
+        case EChessActionType::Move:
+            if (bEnemyToMove)
+            {
+                Action.OrderScore = -ChebyshevDistance(Action.Target.X, Action.Target.Y, Player.X, Player.Y);
+            }
+            else
+            {
+                Action.OrderScore = State.PowerUps[State.Occupancy.ToIndex(Action.Target.X, Action.Target.Y)].Kind != EChessPowerUpKind::None ? 50000 : 0;
+            }
+            break;
+        default:
+            // Passing is the last resort
+            Action.OrderScore = -1;
+            break;
+        }
+    }
+}
+
+void FChessEnemySearch::OrderActions(TArray<FChessAction>& Actions, const FChessAction* TableAction) const
+{
+    Actions.StableSort([TableAction](const FChessAction& A, const FChessAction& B)
+        {
+            if (TableAction)
+            {
+                const bool bA = A == *TableAction;
+                const bool bB = B == *TableAction;
+                if (bA != bB)
+                {
+                    return bA;
+                }
+            }
+            return A.OrderScore > B.OrderScore;
+        });
+}
+
+int32 FChessEnemySearch::Evaluate(const FChessGameState& State, int32 Ply) const
+{
+    // Prefer faster wins and slower losses
+    if (State.Outcome == EChessOutcome::Lose)
+    {
+        return WinScore - Ply;
+    }
+    if (State.Outcome == EChessOutcome::Win)
+    {
+        return -WinScore + Ply;
+    }
+
+    const FChessPieceState& Player = State.Pieces[State.PlayerIndex];
+
+    int32 Score = 0;
+
+    // Player strength
+    Score -= Player.Health * 4;
+    Score -= Player.AttackPower * 2;
+    Score -= Player.RevivesRemaining * 400;
+    Score -= Player.bSuperModeActive ? Player.SuperModeMovesRemaining * 60 : 0;
+
+    // Enemy strength, threats on the player and proximity
+    for (int32 PieceIndex = 0; PieceIndex < State.Pieces.Num(); PieceIndex++)
+    {
+        const FChessPieceState& Enemy = State.Pieces[PieceIndex];
+        if (PieceIndex == State.PlayerIndex || !Enemy.bAlive || Enemy.bPlayerTeam)
+        {
+            continue;
+        }
+
+        Score += 300 + Enemy.Health + Enemy.AttackPower * 2;
+
+        if (FChessRules::CanAttackSquare(State.Occupancy, *State.Tables, Enemy, Player.X, Player.Y))
+        {
+            Score += 250;
+        }
+
+        Score -= ChebyshevDistance(Enemy.X, Enemy.Y, Player.X, Player.Y) * 10;
+    }
+
+    return Score;
+}
+
+uint64 FChessEnemySearch::HashState(const FChessGameState& State, bool bEnemyToMove) const
+{
+    // Pieces and power-ups are hashed incrementally by the state itself
+    uint64 Hash = State.Hash;
+    if (bEnemyToMove)
+    {
+        Hash ^= State.Zobrist->GetEnemyToMoveKey();
+    }
+    if (State.bSkipEnemyTurn)
+    {
+        Hash ^= State.Zobrist->GetSkipEnemyTurnKey();
+    }
+    return Hash;
+}
+
+uint64 FChessEnemySearch::HashExactStats(const FChessGameState& State)
+{
+    // FNV-1a over the stats of every piece, dead ones as a marker
+    uint64 Hash = 0xcbf29ce484222325ull;
+    auto Mix = [&Hash](int32 Value)
+        {
+            Hash = (Hash ^ static_cast<uint32>(Value)) * 0x100000001b3ull;
+        };
+
+    for (const FChessPieceState& Piece : State.Pieces)
+    {
+        if (!Piece.bAlive)
+        {
+            Mix(-1);
+            continue;
+        }
+
+        Mix(Piece.Health);
+        Mix(Piece.AttackPower);
+        Mix(Piece.bSuperModeActive ? Piece.SuperModeMovesRemaining : 0);
+        Mix(Piece.RevivesRemaining);
+    }
+
+    return Hash;
+}
+
+int32 FChessEnemySearch::ToTableScore(int32 Score, int32 Ply)
+{
+    if (Score >= WinScore - MaxMatePly)
+    {
+        return Score + Ply;
+    }
+    if (Score <= -WinScore + MaxMatePly)
+    {
+        return Score - Ply;
+    }
+    return Score;
+}
+
+int32 FChessEnemySearch::FromTableScore(int32 Score, int32 Ply)
+{
+    if (Score >= WinScore - MaxMatePly)
+    {
+        return Score - Ply;
+    }
+    if (Score <= -WinScore + MaxMatePly)
+    {
+        return Score + Ply;
+    }
+    return Score;
+}
+
+bool FChessEnemySearch::IsOutOfTime()
+{
+    if (!bAborted && (Nodes % TimeCheckInterval) == 0 && FPlatformTime::Seconds() > Deadline)
+    {
+        bAborted = true;
+    }
+    return bAborted;
+}
@@ -0,0 +1,98 @@
+// ChessEnemySearch.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessRules.h"
+#include "ChessActions.h"
+#include "ChessUndo.h"
+
+struct FChessSearchSettings
+{
+    // Deepest iteration of iterative deepening, in plies (one enemy action or one player action each)
+    int32 MaxDepth = 6;
+
+    // Wall-clock budget; the deepest fully searched iteration is used when it runs out
+    double TimeBudgetSeconds = 0.05;
+
+    // Transposition table holds 2^N entries
+    int32 TranspositionTableSizeLog2 = 16;
+};
+
+struct FChessSearchResult
+{
+    FChessEnemyAction Action;
+    bool bFoundAction = false;
+    int32 Score = 0;
+    int32 CompletedDepth = 0;
+    int64 NodesSearched = 0;
+    double ElapsedSeconds = 0.0;
+};
+
+/**
+ * Depth-limited minimax with alpha-beta pruning over the one-enemy-acts-per-turn rule.
+ * Enemy plies maximize, player plies minimize a static evaluation from the enemies'
+ * point of view. Uses iterative deepening under a time budget, a transposition table
+ * and move ordering (table move, captures, then proximity to the player).
+ *
+ * Works on its own copy of the state with make/unmake (FChessUndoStack) and per-ply
+ * action buffers, so nodes don't allocate and it can run on any thread.
+ */
+class DUNGEONCHESS_API FChessEnemySearch
+{
+public:
+    explicit FChessEnemySearch(const FChessSearchSettings& InSettings = FChessSearchSettings());
+
+    // Best action for the enemy side in State (the enemy phase that follows the player's action)
+    FChessSearchResult FindBestAction(const FChessGameState& State);
+
+private:
+    enum class EBoundType : uint8
+    {
+        Exact,
+        Lower,
+        Upper
+    };
+
+    struct FTableEntry
+    {
+        uint64 Key = 0;
+
+        // The position hash buckets health and attack power; a hit must also match the exact stats
+        uint64 StatsKey = 0;
+
+        // Win and loss scores are stored relative to this node, not the root
+        int32 Score = 0;
+        int16 Depth = -1;
+        EBoundType Bound = EBoundType::Exact;
+        FChessAction BestAction;
+    };
+
+    int32 Search(FChessGameState& State, int32 Depth, int32 Alpha, int32 Beta, bool bEnemyToMove, int32 Ply);
+
+    // FChessActions lists with ordering hints: captures and eats first, then power-ups and proximity to the player
+    void GenerateActions(const FChessGameState& State, bool bEnemyToMove, TArray<FChessAction>& OutActions) const;
+    void OrderActions(TArray<FChessAction>& Actions, const FChessAction* TableAction) const;
+
+    int32 Evaluate(const FChessGameState& State, int32 Ply) const;
+    uint64 HashState(const FChessGameState& State, bool bEnemyToMove) const;
+    static uint64 HashExactStats(const FChessGameState& State);
+
+    // Win and loss scores count plies from the root; the table keeps them counted from the node
+    static int32 ToTableScore(int32 Score, int32 Ply);
+    static int32 FromTableScore(int32 Score, int32 Ply);
+
+    bool IsOutOfTime();
+
+    FChessSearchSettings Settings;
+    TArray<FTableEntry> Table;
+    uint64 TableMask = 0;
+
+    FChessUndoStack Undo;
+
+    // Candidate actions per ply, reused between nodes
+    TArray<TArray<FChessAction>> PlyActions;
+
+    double Deadline = 0.0;
+    bool bAborted = false;
+    int64 Nodes = 0;
+};
@@ -0,0 +1,284 @@
+// ChessGameLog.cpp
+#include "ChessGameLog.h"
+#include "ChessMovement.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+    uint16 ToLogIndex(int32 Index)
+    {
+        return Index >= 0 && Index < FChessLogRecord::NoIndex ? static_cast<uint16>(Index) : FChessLogRecord::NoIndex;
+    }
+}
+
+FChessGameLog::FChessGameLog(int32 CapacityLog2)
+{
+    const int32 Capacity = 1 << FMath::Clamp(CapacityLog2, 4, 20);
+    Ring.SetNum(Capacity);
+    RingMask = Capacity - 1;
+}
+
+FChessGameLog::~FChessGameLog()
+{
+    Close();
+}
+
+bool FChessGameLog::Begin(const FString& InPath, int32 Seed, int32 Width, int32 InHeight)
+{
+    Close();
+
+    NumAppended = 0;
+    NumFlushed = 0;
+    Height = InHeight;
+    Path = InPath;
+    bActive = true;
+
+    if (Path.IsEmpty())
+    {
+        return true;
+    }
+
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_AllowRead));
+    if (!Writer)
+    {
+        Path.Reset();
+        return false;
+    }
+
+    uint32 Magic = FChessLogHeader::Magic;
+    FChessLogHeader Header;
+    Header.Seed = Seed;
+    Header.Width = static_cast<uint16>(Width);
+    Header.Height = static_cast<uint16>(InHeight);
+    *Writer << Magic << Header.Version << Header.Seed << Header.Width << Header.Height;
+    Writer->Flush();
+    return true;
+}
+
+void FChessGameLog::Flush()
+{
+    if (!Writer)
+    {
+        return;
+    }
+
+    for (uint64 Index = NumFlushed; Index < NumAppended; Index++)
+    {
+        *Writer << Ring[Index & RingMask];
+    }
+    NumFlushed = NumAppended;
+    Writer->Flush();
+}
+
+void FChessGameLog::Close()
+{
+    Flush();
+    if (Writer)
+    {
+        Writer->Close();
+        Writer.Reset();
+    }
+    bActive = false;
+}
+
+void FChessGameLog::Append(const FChessLogRecord& Record)
+{
+    if (!bActive)
+    {
+        return;
+    }
+
+    // Full ring: write out what is pending, or forget the oldest record when memory-only
+    if (NumAppended - NumFlushed > RingMask)
+    {
+        if (Writer)
+        {
+            Flush();
+        }
+        else
+        {
+            NumFlushed++;
+        }
+    }
+
+    Ring[NumAppended & RingMask] = Record;
+    NumAppended++;
+}
+
+uint16 FChessGameLog::ToSquare(int32 X, int32 Y) const
+{
+    return X >= 0 && Y >= 0 && Y < Height ? ToLogIndex(X * Height + Y) : FChessLogRecord::NoIndex;
+}
+
+void FChessGameLog::LogPieceSpawn(int32 PieceIndex, const FChessPieceState& Piece)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::PieceSpawn;
+    Record.Flags = static_cast<uint8>(Piece.Kind) | (Piece.bPlayerTeam ? 1 << 4 : 0);
+    Record.Piece = ToLogIndex(PieceIndex);
+    Record.Target = ToSquare(Piece.X, Piece.Y);
+    Record.Param = static_cast<uint16>(FMath::Clamp(Piece.MovementRange, 0, 255) | FMath::Clamp(Piece.RevivesRemaining, 0, 255) << 8);
+    Record.Value = Piece.Health;
+    Record.Value2 = Piece.AttackPower;
+    Append(Record);
+
+    if (Piece.Movement)
+    {
+        const uint64 HashKey = Piece.Movement->GetHashKey();
+
+        FChessLogRecord MovementRecord;
+        MovementRecord.Type = EChessLogEvent::PieceMovement;
+        MovementRecord.Piece = ToLogIndex(PieceIndex);
+        MovementRecord.Value = static_cast<int32>(HashKey & 0xFFFFFFFF);
+        MovementRecord.Value2 = static_cast<int32>(HashKey >> 32);
+        Append(MovementRecord);
+    }
+}
+
+void FChessGameLog::LogPowerUpSpawn(int32 X, int32 Y, const FChessPowerUpState& PowerUp)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::PowerUpSpawn;
+    Record.Flags = static_cast<uint8>(PowerUp.Kind);
+    Record.Target = ToSquare(X, Y);
+    Record.Value = PowerUp.SuperModeMoves;
+    Append(Record);
+}
+
+void FChessGameLog::LogTurnStart(int32 Turn, uint64 PositionHash)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::TurnStart;
+    Record.Value = Turn;
+    Record.Value2 = static_cast<int32>(PositionHash & 0xFFFFFFFF);
+    Append(Record);
+}
+
+void FChessGameLog::LogEnemyChoice(int32 PieceIndex, int32 X, int32 Y, bool bAttack, bool bSearch)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::EnemyChoice;
+    Record.Flags = (bAttack ? 1 : 0) | (bSearch ? 2 : 0);
+    Record.Piece = ToLogIndex(PieceIndex);
+    Record.Target = ToSquare(X, Y);
+    Append(Record);
+}
+
+void FChessGameLog::LogUndo(int32 Turn)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::Undo;
+    Record.Value = Turn;
+    Append(Record);
+}
+
+void FChessGameLog::LogGameEnd(EChessOutcome Outcome)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::GameEnd;
+    Record.Flags = static_cast<uint8>(Outcome);
+    Append(Record);
+}
+
+void FChessGameLog::LogMove(int32 PieceIndex, int32 X, int32 Y)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::Move;
+    Record.Piece = ToLogIndex(PieceIndex);
+    Record.Target = ToSquare(X, Y);
+    Append(Record);
+}
+
+void FChessGameLog::LogClash(int32 AttackerIndex, int32 TargetIndex, EChessCombatResult Result)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::Clash;
+    Record.Flags = static_cast<uint8>(Result);
+    Record.Piece = ToLogIndex(AttackerIndex);
+    Record.Target = ToLogIndex(TargetIndex);
+    Append(Record);
+}
+
+void FChessGameLog::LogJumpCapture(int32 AttackerIndex, int32 X, int32 Y, EChessCombatResult Result)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::JumpCapture;
+    Record.Flags = static_cast<uint8>(Result);
+    Record.Piece = ToLogIndex(AttackerIndex);
+    Record.Target = ToSquare(X, Y);
+    Append(Record);
+}
+
+void FChessGameLog::LogSuperModeSpent(int32 PieceIndex)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::SuperModeSpent;
+    Record.Piece = ToLogIndex(PieceIndex);
+    Append(Record);
+}
+
+void FChessGameLog::LogPickup(int32 PieceIndex, int32 X, int32 Y, EChessPowerUpKind Kind)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::Pickup;
+    Record.Flags = static_cast<uint8>(Kind);
+    Record.Piece = ToLogIndex(PieceIndex);
+    Record.Target = ToSquare(X, Y);
+    Append(Record);
+}
+
+void FChessGameLog::LogRevive(int32 PieceIndex, int32 RevivesRemaining)
+{
+    FChessLogRecord Record;
+    Record.Type = EChessLogEvent::Revive;
+    Record.Piece = ToLogIndex(PieceIndex);
+    Record.Value = RevivesRemaining;
+    Append(Record);
+}
+
+void FChessGameLog::GetRecentRecords(TArray<FChessLogRecord>& OutRecords) const
+{
+    OutRecords.Reset();
+
+    const uint64 NumHeld = FMath::Min<uint64>(NumAppended, RingMask + 1);
+    for (uint64 Index = NumAppended - NumHeld; Index < NumAppended; Index++)
+    {
+        OutRecords.Add(Ring[Index & RingMask]);
+    }
+}
+
+bool FChessGameLog::Load(const FString& InPath, FChessLogHeader& OutHeader, TArray<FChessLogRecord>& OutRecords, FString& OutError)
+{
+    OutRecords.Reset();
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InPath));
+    if (!Reader)
+    {
+        OutError = FString::Printf(TEXT("cannot open %s"), *InPath);
+        return false;
+    }
+
+    uint32 Magic = 0;
+    *Reader << Magic << OutHeader.Version << OutHeader.Seed << OutHeader.Width << OutHeader.Height;
+    if (Reader->IsError() || Magic != FChessLogHeader::Magic)
+    {
+        OutError = FString::Printf(TEXT("%s is not a game log"), *InPath);
+        return false;
+    }
+
+    if (OutHeader.Version != FChessLogHeader::CurrentVersion)
+    {
+        OutError = FString::Printf(TEXT("%s has version %d, expected %d"), *InPath, OutHeader.Version, FChessLogHeader::CurrentVersion);
+        return false;
+    }
+
+    // A log cut short by a crash ends on a partial record; keep everything before it
+    constexpr int64 RecordSize = 16;
+    OutRecords.Reserve(static_cast<int32>((Reader->TotalSize() - Reader->Tell()) / RecordSize));
+    while (Reader->TotalSize() - Reader->Tell() >= RecordSize)
+    {
+        *Reader << OutRecords.AddDefaulted_GetRef();
+    }
+
+    return !Reader->IsError();
+}
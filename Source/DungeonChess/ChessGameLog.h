@@ -0,0 +1,119 @@
+// ChessGameLog.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessRules.h"
+
+// One entry per game action. Values are part of the file format - append only.
+enum class EChessLogEvent : uint8
+{
+    PieceSpawn,         // Piece, Target = square, Flags = kind | team << 4, Param = movement range | revives << 8, Value = health, Value2 = attack power
+    PowerUpSpawn,       // Target = square, Flags = kind, Value = super mode moves
+    TurnStart,          // Value = turn, Value2 = low 32 bits of the position hash
+    Move,               // Piece, Target = square
+    Clash,              // Piece = attacker, Target = target piece, Flags = EChessCombatResult
+    JumpCapture,        // Piece = attacker, Target = square, Flags = EChessCombatResult
+    SuperModeSpent,     // Piece
+    Pickup,             // Piece, Target = square, Flags = kind
+    Revive,             // Piece, Value = revives remaining
+    EnemyChoice,        // Piece, Target = square or NoIndex, Flags = bAttack | bSearch << 1
+    Undo,               // Value = turn rewound to
+    GameEnd,            // Flags = EChessOutcome
+    PieceMovement       // Piece, Value/Value2 = low/high 32 bits of the custom movement program hash; follows its PieceSpawn
+};
+
+/**
+ * Fixed-size binary record, 16 bytes on disk. Pieces are referred to by roster index
+ * (AChessPieceBase::RosterIndex, the FChessGameState piece index), squares by board index.
+ */
+struct FChessLogRecord
+{
+    static constexpr uint16 NoIndex = 0xFFFF;
+
+    EChessLogEvent Type = EChessLogEvent::TurnStart;
+    uint8 Flags = 0;
+    uint16 Piece = NoIndex;
+    uint16 Target = NoIndex;
+    uint16 Param = 0;
+    int32 Value = 0;
+    int32 Value2 = 0;
+
+    friend FArchive& operator<<(FArchive& Ar, FChessLogRecord& Record)
+    {
+        uint8 Type = static_cast<uint8>(Record.Type);
+        Ar << Type << Record.Flags << Record.Piece << Record.Target << Record.Param << Record.Value << Record.Value2;
+        Record.Type = static_cast<EChessLogEvent>(Type);
+        return Ar;
+    }
+};
+
+struct FChessLogHeader
+{
+    static constexpr uint32 Magic = 0x474C4344; // "DCLG"
+    static constexpr uint16 CurrentVersion = 1;
+
+    uint16 Version = CurrentVersion;
+    int32 Seed = 0;
+    uint16 Width = 0;
+    uint16 Height = 0;
+};
+
+/**
+ * Event-sourced record of one game. Records go into a fixed ring buffer and are written
+ * to the file on Flush, or automatically when the buffer fills up. Without a file the
+ * ring simply keeps the most recent records in memory.
+ */
+class DUNGEONCHESS_API FChessGameLog
+{
+public:
+    explicit FChessGameLog(int32 CapacityLog2 = 12);
+    ~FChessGameLog();
+
+    // Starts a new game; an empty path keeps the log in memory only
+    bool Begin(const FString& Path, int32 Seed, int32 Width, int32 Height);
+    void Flush();
+    void Close();
+
+    bool IsActive() const { return bActive; }
+    const FString& GetPath() const { return Path; }
+
+    // Setup. Custom pieces also get a PieceMovement record.
+    void LogPieceSpawn(int32 PieceIndex, const FChessPieceState& Piece);
+    void LogPowerUpSpawn(int32 X, int32 Y, const FChessPowerUpState& PowerUp);
+
+    // Turn flow
+    void LogTurnStart(int32 Turn, uint64 PositionHash);
+    void LogEnemyChoice(int32 PieceIndex, int32 X, int32 Y, bool bAttack, bool bSearch);
+    void LogUndo(int32 Turn);
+    void LogGameEnd(EChessOutcome Outcome);
+
+    // Actions
+    void LogMove(int32 PieceIndex, int32 X, int32 Y);
+    void LogClash(int32 AttackerIndex, int32 TargetIndex, EChessCombatResult Result);
+    void LogJumpCapture(int32 AttackerIndex, int32 X, int32 Y, EChessCombatResult Result);
+    void LogSuperModeSpent(int32 PieceIndex);
+    void LogPickup(int32 PieceIndex, int32 X, int32 Y, EChessPowerUpKind Kind);
+    void LogRevive(int32 PieceIndex, int32 RevivesRemaining);
+
+    // The last records still held by the ring, oldest first
+    void GetRecentRecords(TArray<FChessLogRecord>& OutRecords) const;
+
+    // Reads a whole log file back
+    static bool Load(const FString& InPath, FChessLogHeader& OutHeader, TArray<FChessLogRecord>& OutRecords, FString& OutError);
+
+private:
+    void Append(const FChessLogRecord& Record);
+    uint16 ToSquare(int32 X, int32 Y) const;
+
+    TArray<FChessLogRecord> Ring;
+    uint64 RingMask = 0;
+
+    // Total records appended and total written (or dropped) since Begin
+    uint64 NumAppended = 0;
+    uint64 NumFlushed = 0;
+
+    TUniquePtr<FArchive> Writer;
+    FString Path;
+    int32 Height = 0;
+    bool bActive = false;
+};
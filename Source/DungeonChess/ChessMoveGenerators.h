@@ -0,0 +1,166 @@
+// ChessMoveGenerators.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessRules.h"
+#include "Templates/IntegerSequence.h"
+
+/**
+ * Move generators specialized at compile time for the built-in piece kinds. Direction
+ * set, range and blocking rule are template parameters, so each instantiation walks a
+ * fixed list of rays (or leap offsets) with no per-direction table lookups or mode
+ * branches left in the inner loop. FChessRules picks the instantiation once per piece
+ * from its EChessPieceKind; custom pieces go through their FChessMovementProgram.
+ *
+ * Output order matches FChessMovementProgram for the same pattern.
+ */
+namespace ChessMoveGen
+{
+    // Range to the edge of the board
+    inline constexpr int32 Unlimited = MAX_int32;
+
+    // Range taken from FChessPieceState::MovementRange at run time
+    inline constexpr int32 PieceRange = -1;
+
+    enum class ERayMode : uint8
+    {
+        Moves,          // Empty tiles up to the first piece
+        MovesPassOver,  // Empty tiles, sliding past pieces
+        Attacks,        // First piece on the ray, if it is an opponent
+        Range           // Every tile up to and including the first piece
+    };
+
+    enum class ELeapMode : uint8
+    {
+        Moves,          // Empty targets, plus opponents when captures are allowed
+        Attacks,        // Opponents only
+        Range           // Every on-board target
+    };
+
+    template <ERayMode Mode, int32 Dir>
+    FORCEINLINE void WalkRay(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, int32 Origin, int32 Range, FChessTileList& OutTiles)
+    {
+        constexpr EChessDirection Direction = static_cast<EChessDirection>(Dir);
+        constexpr int32 DX = ChessGridSteps::Directions[Dir].X;
+        constexpr int32 DY = ChessGridSteps::Directions[Dir].Y;
+
+        const int32 Step = Tables.GetRayStep(Direction);
+        const int32 Length = FMath::Min(Tables.GetRayLength(Origin, Direction), Range);
+
+        int32 Square = Origin;
+        for (int32 i = 1; i <= Length; i++)
+        {
+            Square += Step;
+            const bool bOccupied = Occupancy.IsOccupied(Square);
+
+            if constexpr (Mode == ERayMode::Moves)
+            {
+                if (bOccupied)
+                {
+                    break;
+                }
+                OutTiles.Emplace(Piece.X + DX * i, Piece.Y + DY * i);
+            }
+            else if constexpr (Mode == ERayMode::MovesPassOver)
+            {
+                if (!bOccupied)
+                {
+                    OutTiles.Emplace(Piece.X + DX * i, Piece.Y + DY * i);
+                }
+            }
+            else if constexpr (Mode == ERayMode::Attacks)
+            {
+                if (bOccupied)
+                {
+                    if (Occupancy.IsOpponentAt(Square, Piece.bPlayerTeam))
+                    {
+                        OutTiles.Emplace(Piece.X + DX * i, Piece.Y + DY * i);
+                    }
+                    break;
+                }
+            }
+            else
+            {
+                OutTiles.Emplace(Piece.X + DX * i, Piece.Y + DY * i);
+                if (bOccupied)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    template <ERayMode Mode, uint8 DirectionMask, int32... Dirs>
+    FORCEINLINE void WalkRays(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, int32 Origin, int32 Range, FChessTileList& OutTiles, TIntegerSequence<int32, Dirs...>)
+    {
+        // Directions outside the mask fold away; the rest run in EChessDirection order
+        ([&]
+        {
+            if constexpr (((DirectionMask >> Dirs) & 1) != 0)
+            {
+                WalkRay<Mode, Dirs>(Occupancy, Tables, Piece, Origin, Range, OutTiles);
+            }
+        }(), ...);
+    }
+
+    // Sliding pattern. DirectionMask has a bit per EChessDirection (EChessDirectionMask).
+    template <ERayMode Mode, uint8 DirectionMask, int32 MaxRange>
+    FORCEINLINE void GenerateRays(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles)
+    {
+        int32 Range = MaxRange;
+        if constexpr (MaxRange == PieceRange)
+        {
+            Range = Piece.MovementRange;
+        }
+
+        const int32 Origin = Occupancy.ToIndex(Piece.X, Piece.Y);
+        WalkRays<Mode, DirectionMask>(Occupancy, Tables, Piece, Origin, Range, OutTiles, TMakeIntegerSequence<int32, FChessMoveTables::NumDirections>());
+    }
+
+    template <ELeapMode Mode, const FChessGridStep (&Steps)[8], int32 Index>
+    FORCEINLINE void TryLeap(const FChessOccupancy& Occupancy, const FChessPieceState& Piece, bool bCapture, FChessTileList& OutTiles)
+    {
+        const int32 TargetX = Piece.X + Steps[Index].X;
+        const int32 TargetY = Piece.Y + Steps[Index].Y;
+        if (!Occupancy.IsInside(TargetX, TargetY))
+        {
+            return;
+        }
+
+        if constexpr (Mode == ELeapMode::Range)
+        {
+            OutTiles.Emplace(TargetX, TargetY);
+        }
+        else
+        {
+            const int32 Target = Occupancy.ToIndex(TargetX, TargetY);
+            const bool bOpponent = Occupancy.IsOpponentAt(Target, Piece.bPlayerTeam);
+
+            if constexpr (Mode == ELeapMode::Moves)
+            {
+                if (!Occupancy.IsOccupied(Target) || (bCapture && bOpponent))
+                {
+                    OutTiles.Emplace(TargetX, TargetY);
+                }
+            }
+            else if (bOpponent)
+            {
+                OutTiles.Emplace(TargetX, TargetY);
+            }
+        }
+    }
+
+    template <ELeapMode Mode, const FChessGridStep (&Steps)[8], int32... Indices>
+    FORCEINLINE void TryLeaps(const FChessOccupancy& Occupancy, const FChessPieceState& Piece, bool bCapture, FChessTileList& OutTiles, TIntegerSequence<int32, Indices...>)
+    {
+        (TryLeap<Mode, Steps, Indices>(Occupancy, Piece, bCapture, OutTiles), ...);
+    }
+
+    // Leaper pattern over a fixed offset table (ChessGridSteps::Knight or King).
+    // bCapture lets moves also land on opponents (the player eating in super mode).
+    template <ELeapMode Mode, const FChessGridStep (&Steps)[8]>
+    FORCEINLINE void GenerateLeaps(const FChessOccupancy& Occupancy, const FChessPieceState& Piece, bool bCapture, FChessTileList& OutTiles)
+    {
+        TryLeaps<Mode, Steps>(Occupancy, Piece, bCapture, OutTiles, TMakeIntegerSequence<int32, 8>());
+    }
+}
@@ -0,0 +1,59 @@
+// ChessMoveTables.cpp
+#include "ChessMoveTables.h"
+#include "Misc/ScopeLock.h"
+
+TSharedRef<const FChessMoveTables> FChessMoveTables::Get(int32 Width, int32 Height)
+{
+    // Boards of the same size share one set of tables
+    static FCriticalSection CacheLock;
+    static TMap<FIntPoint, TSharedRef<const FChessMoveTables>> Cache;
+
+    const FIntPoint Key(FMath::Max(Width, 0), FMath::Max(Height, 0));
+
+    FScopeLock Lock(&CacheLock);
+    if (const TSharedRef<const FChessMoveTables>* Found = Cache.Find(Key))
+    {
+        return *Found;
+    }
+
+    TSharedRef<FChessMoveTables> Tables = MakeShared<FChessMoveTables>();
+    Tables->Build(Key.X, Key.Y);
+    Cache.Add(Key, Tables);
+    return Tables;
+}
+
+void FChessMoveTables::Build(int32 InWidth, int32 InHeight)
+{
+    Width = InWidth;
+    Height = InHeight;
+
+    const int32 Squares = Width * Height;
+
+    for (int32 Dir = 0; Dir < NumDirections; Dir++)
+    {
+        RaySteps[Dir] = ChessGridSteps::Directions[Dir].X * Height + ChessGridSteps::Directions[Dir].Y;
+    }
+
+    RayLengths.SetNumUninitialized(Squares * NumDirections);
+    for (int32 X = 0; X < Width; X++)
+    {
+        for (int32 Y = 0; Y < Height; Y++)
+        {
+            const int32 Square = X * Height + Y;
+            for (int32 Dir = 0; Dir < NumDirections; Dir++)
+            {
+                const FChessGridStep& Offset = ChessGridSteps::Directions[Dir];
+                int32 Length = 0;
+                int32 CheckX = X + Offset.X;
+                int32 CheckY = Y + Offset.Y;
+                while (CheckX >= 0 && CheckX < Width && CheckY >= 0 && CheckY < Height)
+                {
+                    Length++;
+                    CheckX += Offset.X;
+                    CheckY += Offset.Y;
+                }
+                RayLengths[Square * NumDirections + Dir] = static_cast<uint16>(Length);
+            }
+        }
+    }
+}
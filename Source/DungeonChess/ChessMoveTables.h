@@ -0,0 +1,85 @@
+// ChessMoveTables.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Caller-owned output buffer for move queries. Inline storage covers the common
+// case so generating moves does not touch the heap.
+typedef TArray<FIntPoint, TInlineAllocator<64>> FChessTileList;
+
+// Ray directions, in the order the slider pieces walk them
+enum class EChessDirection : uint8
+{
+    PlusX,          // ( 1,  0)
+    MinusX,         // (-1,  0)
+    PlusY,          // ( 0,  1)
+    MinusY,         // ( 0, -1)
+    PlusXPlusY,     // ( 1,  1)
+    MinusXMinusY,   // (-1, -1)
+    PlusXMinusY,    // ( 1, -1)
+    MinusXPlusY,    // (-1,  1)
+    Count
+};
+
+// Grid offset usable in constant expressions
+struct FChessGridStep
+{
+    int8 X;
+    int8 Y;
+};
+
+// The grid offsets every generator walks: constexpr so the specialized generators in
+// ChessMoveGenerators.h can unroll over them, and read at runtime by the move tables and
+// the movement programs.
+namespace ChessGridSteps
+{
+    // Offset of each EChessDirection
+    inline constexpr FChessGridStep Directions[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, -1 }, { 1, -1 }, { -1, 1 } };
+
+    // L-shaped knight jumps, in the order AKnightChessPiece reports them
+    inline constexpr FChessGridStep Knight[] = { { 2, 1 }, { 1, 2 }, { -1, 2 }, { -2, 1 }, { -2, -1 }, { -1, -2 }, { 1, -2 }, { 2, -1 } };
+
+    // King steps, in the order APlayerChessPiece reports them
+    inline constexpr FChessGridStep King[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+}
+
+/**
+ * Per-board-size lookup tables for move generation.
+ * Square index follows the board's tile layout: Index = X * BoardHeight + Y.
+ *
+ * Rays are stored as a length-to-edge per square and direction, so a ray is
+ * Square + Step * k for k in [1, Length]. Leapers need no table: their few
+ * offsets are bounds-checked directly.
+ */
+class DUNGEONCHESS_API FChessMoveTables
+{
+public:
+    static constexpr int32 NumDirections = static_cast<int32>(EChessDirection::Count);
+
+    // Returns shared tables for the given board size, building them on first use
+    static TSharedRef<const FChessMoveTables> Get(int32 Width, int32 Height);
+
+    FORCEINLINE int32 GetWidth() const { return Width; }
+    FORCEINLINE int32 GetHeight() const { return Height; }
+
+    // Number of on-board squares from Square (exclusive) to the edge along Dir
+    FORCEINLINE int32 GetRayLength(int32 Square, EChessDirection Dir) const
+    {
+        return RayLengths[Square * NumDirections + static_cast<int32>(Dir)];
+    }
+
+    // Square index delta of one step along Dir
+    FORCEINLINE int32 GetRayStep(EChessDirection Dir) const
+    {
+        return RaySteps[static_cast<int32>(Dir)];
+    }
+
+private:
+    void Build(int32 InWidth, int32 InHeight);
+
+    int32 Width = 0;
+    int32 Height = 0;
+
+    int32 RaySteps[NumDirections] = {};
+    TArray<uint16> RayLengths;
+};
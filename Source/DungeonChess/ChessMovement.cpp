@@ -0,0 +1,392 @@
+// ChessMovement.cpp
+#include "ChessMovement.h"
+#include "ChessRules.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    // Identical definitions share one program, which is never freed
+    struct FProgramCache
+    {
+        FCriticalSection Lock;
+        TMap<uint64, TUniquePtr<FChessMovementProgram>> Programs;
+    };
+
+    FProgramCache& GetProgramCache()
+    {
+        static FProgramCache Cache;
+        return Cache;
+    }
+
+    FChessRuleSet MakeRays(uint8 Directions, int32 MaxRange, EChessRayBlocking Blocking = EChessRayBlocking::Stop)
+    {
+        FChessRuleSet Rules;
+        FChessRayRule& Ray = Rules.Rays.AddDefaulted_GetRef();
+        Ray.Directions = Directions;
+        Ray.MaxRange = MaxRange;
+        Ray.Blocking = Blocking;
+        return Rules;
+    }
+
+    template <int32 NumSteps>
+    FChessRuleSet MakeLeaps(const FChessGridStep (&Steps)[NumSteps])
+    {
+        FChessRuleSet Rules;
+        for (const FChessGridStep& Step : Steps)
+        {
+            Rules.Leaps.Emplace(Step.X, Step.Y);
+        }
+        return Rules;
+    }
+
+    FChessMovementDesc MakeBuiltInDesc(EChessPieceKind Kind)
+    {
+        FChessMovementDesc Desc;
+
+        switch (Kind)
+        {
+        case EChessPieceKind::Basic:
+        {
+            // Up to MovementRange tiles in any cardinal direction; adjacent attacks, diagonals too in super mode
+            FChessRayRule& Ray = Desc.Moves.Rays.AddDefaulted_GetRef();
+            Ray.Directions = EChessDirectionMask::Orthogonal;
+            Ray.bRangeFromPiece = true;
+            Desc.Attacks = MakeRays(EChessDirectionMask::Orthogonal, 1);
+            Desc.SuperModeAttacks = MakeRays(EChessDirectionMask::All, 1);
+            Desc.bRangeFromAttacks = true;
+            break;
+        }
+
+        case EChessPieceKind::Player:
+            // King steps onto empty tiles; in super mode also onto enemies (eating them)
+            Desc.Moves = MakeLeaps(ChessGridSteps::King);
+            Desc.Attacks = Desc.Moves;
+            Desc.bRangeFromAttacks = true;
+            Desc.bSuperModeMovesCapture = true;
+            break;
+
+        case EChessPieceKind::Rook:
+            // Slides to the edge of the board, landing on any empty tile along the way
+            Desc.Moves = MakeRays(EChessDirectionMask::Orthogonal, 0, EChessRayBlocking::PassOver);
+            Desc.Attacks = MakeRays(EChessDirectionMask::Orthogonal, 0);
+            Desc.Range = Desc.Attacks;
+            break;
+
+        case EChessPieceKind::Knight:
+            // Knight jumps, so every L-shaped square is in range
+            Desc.Moves = MakeLeaps(ChessGridSteps::Knight);
+            Desc.Attacks = Desc.Moves;
+            Desc.Range = Desc.Moves;
+            break;
+
+        case EChessPieceKind::Bishop:
+            Desc.Moves = MakeRays(EChessDirectionMask::Diagonal, FChessRules::BishopMaxRange, EChessRayBlocking::PassOver);
+            Desc.Attacks = MakeRays(EChessDirectionMask::Diagonal, FChessRules::BishopMaxRange);
+            Desc.Range = Desc.Attacks;
+            break;
+
+        case EChessPieceKind::Queen:
+            Desc.Moves = MakeRays(EChessDirectionMask::All, FChessRules::QueenMaxMoveRange);
+            Desc.Attacks = MakeRays(EChessDirectionMask::All, FChessRules::QueenMaxAttackRange);
+            Desc.Range = MakeRays(EChessDirectionMask::All, FChessRules::QueenMaxMoveRange);
+            break;
+
+        default:
+            // Custom pieces without a program neither move nor attack
+            break;
+        }
+
+        return Desc;
+    }
+}
+
+const FChessMovementProgram* FChessMovementProgram::Intern(const FChessMovementDesc& Desc)
+{
+    TUniquePtr<FChessMovementProgram> Program = MakeUnique<FChessMovementProgram>();
+    Program->Compile(Desc);
+
+    FProgramCache& Cache = GetProgramCache();
+    FScopeLock Lock(&Cache.Lock);
+    if (const TUniquePtr<FChessMovementProgram>* Found = Cache.Programs.Find(Program->HashKey))
+    {
+        return Found->Get();
+    }
+
+    const uint64 Key = Program->HashKey;
+    return Cache.Programs.Add(Key, MoveTemp(Program)).Get();
+}
+
+const FChessMovementProgram* FChessMovementProgram::Find(uint64 HashKey)
+{
+    FProgramCache& Cache = GetProgramCache();
+    FScopeLock Lock(&Cache.Lock);
+    const TUniquePtr<FChessMovementProgram>* Found = Cache.Programs.Find(HashKey);
+    return Found ? Found->Get() : nullptr;
+}
+
+const FChessMovementProgram& FChessMovementProgram::GetBuiltIn(EChessPieceKind Kind)
+{
+    static const FChessMovementProgram* BuiltIns[] = {
+        Intern(MakeBuiltInDesc(EChessPieceKind::Basic)),
+        Intern(MakeBuiltInDesc(EChessPieceKind::Player)),
+        Intern(MakeBuiltInDesc(EChessPieceKind::Rook)),
+        Intern(MakeBuiltInDesc(EChessPieceKind::Knight)),
+        Intern(MakeBuiltInDesc(EChessPieceKind::Bishop)),
+        Intern(MakeBuiltInDesc(EChessPieceKind::Queen)),
+        Intern(MakeBuiltInDesc(EChessPieceKind::Custom))
+    };
+
+    const int32 Index = static_cast<int32>(Kind);
+    return *BuiltIns[Index < UE_ARRAY_COUNT(BuiltIns) ? Index : static_cast<int32>(EChessPieceKind::Custom)];
+}
+
+void FChessMovementProgram::Compile(const FChessMovementDesc& Desc)
+{
+    Rays.Reset();
+    Leaps.Reset();
+
+    CompileSet(SetMoves, Desc.Moves);
+    CompileSet(SetAttacks, Desc.Attacks);
+    CompileSet(SetSuperModeAttacks, Desc.SuperModeAttacks.Rays.Num() + Desc.SuperModeAttacks.Leaps.Num() > 0 ? Desc.SuperModeAttacks : Desc.Attacks);
+    CompileSet(SetRange, Desc.Range);
+
+    bRangeFromAttacks = Desc.bRangeFromAttacks;
+    bSuperModeMovesCapture = Desc.bSuperModeMovesCapture;
+
+    // Hash the compiled form field by field, so padding never leaks into the key
+    TArray<int32> Words;
+    for (const FRayOp& Op : Rays)
+    {
+        Words.Add(static_cast<int32>(Op.Dir) | (Op.bPassOver ? 1 << 8 : 0) | (Op.bRangeFromPiece ? 1 << 9 : 0));
+        Words.Add(Op.MaxRange);
+    }
+    for (const FIntPoint& Leap : Leaps)
+    {
+        Words.Add(Leap.X);
+        Words.Add(Leap.Y);
+    }
+    for (const FSegment& Segment : Segments)
+    {
+        Words.Add(Segment.RayEnd);
+        Words.Add(Segment.LeapEnd);
+    }
+    Words.Add((bRangeFromAttacks ? 1 : 0) | (bSuperModeMovesCapture ? 2 : 0));
+
+    HashKey = CityHash64(reinterpret_cast<const char*>(Words.GetData()), Words.Num() * sizeof(int32));
+}
+
+void FChessMovementProgram::CompileSet(ESet Set, const FChessRuleSet& Rules)
+{
+    FSegment& Segment = Segments[Set];
+
+    // Each rule expands into one op per direction, walked in EChessDirection order
+    Segment.RayBegin = Rays.Num();
+    for (const FChessRayRule& Rule : Rules.Rays)
+    {
+        for (int32 Dir = 0; Dir < FChessMoveTables::NumDirections; Dir++)
+        {
+            if (Rule.Directions & (1 << Dir))
+            {
+                FRayOp& Op = Rays.AddDefaulted_GetRef();
+                Op.Dir = static_cast<EChessDirection>(Dir);
+                Op.bPassOver = Rule.Blocking == EChessRayBlocking::PassOver;
+                Op.bRangeFromPiece = Rule.bRangeFromPiece;
+                Op.MaxRange = Rule.bRangeFromPiece || Rule.MaxRange <= 0 ? MAX_int32 : Rule.MaxRange;
+            }
+        }
+    }
+    Segment.RayEnd = Rays.Num();
+
+    Segment.LeapBegin = Leaps.Num();
+    for (const FIntPoint& Leap : Rules.Leaps)
+    {
+        if (Leap != FIntPoint::ZeroValue)
+        {
+            Leaps.Add(Leap);
+        }
+    }
+    Segment.LeapEnd = Leaps.Num();
+}
+
+const FChessMovementProgram::FSegment& FChessMovementProgram::GetAttackSegment(const FChessPieceState& Piece) const
+{
+    return Segments[Piece.bSuperModeActive ? SetSuperModeAttacks : SetAttacks];
+}
+
+void FChessMovementProgram::GatherMoves(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const
+{
+    OutTiles.Reset();
+
+    if (!Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        return;
+    }
+
+    const int32 Origin = Occupancy.ToIndex(Piece.X, Piece.Y);
+    const bool bCapture = bSuperModeMovesCapture && Piece.bSuperModeActive;
+    const FSegment& Segment = Segments[SetMoves];
+
+    for (int32 OpIndex = Segment.RayBegin; OpIndex < Segment.RayEnd; OpIndex++)
+    {
+        const FRayOp& Op = Rays[OpIndex];
+        const FChessGridStep& Offset = ChessGridSteps::Directions[static_cast<int32>(Op.Dir)];
+        const int32 Step = Tables.GetRayStep(Op.Dir);
+        const int32 Length = FMath::Min(Tables.GetRayLength(Origin, Op.Dir), Op.bRangeFromPiece ? Piece.MovementRange : Op.MaxRange);
+
+        int32 Square = Origin;
+        for (int32 i = 1; i <= Length; i++)
+        {
+            Square += Step;
+            if (Occupancy.IsOccupied(Square))
+            {
+                if (bCapture && Occupancy.IsOpponentAt(Square, Piece.bPlayerTeam))
+                {
+                    OutTiles.Emplace(Piece.X + Offset.X * i, Piece.Y + Offset.Y * i);
+                }
+                if (!Op.bPassOver)
+                {
+                    break;
+                }
+                continue;
+            }
+
+            OutTiles.Emplace(Piece.X + Offset.X * i, Piece.Y + Offset.Y * i);
+        }
+    }
+
+    for (int32 LeapIndex = Segment.LeapBegin; LeapIndex < Segment.LeapEnd; LeapIndex++)
+    {
+        const int32 TargetX = Piece.X + Leaps[LeapIndex].X;
+        const int32 TargetY = Piece.Y + Leaps[LeapIndex].Y;
+        if (!Occupancy.IsInside(TargetX, TargetY))
+        {
+            continue;
+        }
+
+        const int32 Target = Occupancy.ToIndex(TargetX, TargetY);
+        if (!Occupancy.IsOccupied(Target) || (bCapture && Occupancy.IsOpponentAt(Target, Piece.bPlayerTeam)))
+        {
+            OutTiles.Emplace(TargetX, TargetY);
+        }
+    }
+}
+
+void FChessMovementProgram::GatherAttacks(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const
+{
+    OutTiles.Reset();
+
+    if (!Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        return;
+    }
+
+    const int32 Origin = Occupancy.ToIndex(Piece.X, Piece.Y);
+    const FSegment& Segment = GetAttackSegment(Piece);
+
+    for (int32 OpIndex = Segment.RayBegin; OpIndex < Segment.RayEnd; OpIndex++)
+    {
+        const FRayOp& Op = Rays[OpIndex];
+        const int32 Step = Tables.GetRayStep(Op.Dir);
+        const int32 Length = FMath::Min(Tables.GetRayLength(Origin, Op.Dir), Op.bRangeFromPiece ? Piece.MovementRange : Op.MaxRange);
+
+        int32 Square = Origin;
+        for (int32 i = 1; i <= Length; i++)
+        {
+            Square += Step;
+            if (Occupancy.IsOccupied(Square))
+            {
+                // First piece on the ray: attackable if hostile, and nothing behind it is
+                if (Occupancy.IsOpponentAt(Square, Piece.bPlayerTeam))
+                {
+                    const FChessGridStep& Offset = ChessGridSteps::Directions[static_cast<int32>(Op.Dir)];
+                    OutTiles.Emplace(Piece.X + Offset.X * i, Piece.Y + Offset.Y * i);
+                }
+                break;
+            }
+        }
+    }
+
+    for (int32 LeapIndex = Segment.LeapBegin; LeapIndex < Segment.LeapEnd; LeapIndex++)
+    {
+        const int32 TargetX = Piece.X + Leaps[LeapIndex].X;
+        const int32 TargetY = Piece.Y + Leaps[LeapIndex].Y;
+        if (Occupancy.IsInside(TargetX, TargetY) && Occupancy.IsOpponentAt(Occupancy.ToIndex(TargetX, TargetY), Piece.bPlayerTeam))
+        {
+            OutTiles.Emplace(TargetX, TargetY);
+        }
+    }
+}
+
+void FChessMovementProgram::GatherRange(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const
+{
+    if (bRangeFromAttacks)
+    {
+        // No separate range - same as the attackable tiles
+        GatherAttacks(Occupancy, Tables, Piece, OutTiles);
+        return;
+    }
+
+    GatherSegmentRange(Segments[SetRange], Occupancy, Tables, Piece, OutTiles);
+}
+
+void FChessMovementProgram::GatherAttackScan(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const
+{
+    GatherSegmentRange(GetAttackSegment(Piece), Occupancy, Tables, Piece, OutTiles);
+}
+
+void FChessMovementProgram::GatherRangeScan(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const
+{
+    // Attacks look at every tile up to the first piece, hostile or not, so an empty tile can turn into an attack
+    if (bRangeFromAttacks)
+    {
+        GatherAttackScan(Occupancy, Tables, Piece, OutTiles);
+    }
+    else
+    {
+        GatherRange(Occupancy, Tables, Piece, OutTiles);
+    }
+}
+
+void FChessMovementProgram::GatherSegmentRange(const FSegment& Segment, const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const
+{
+    OutTiles.Reset();
+
+    if (!Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        return;
+    }
+
+    const int32 Origin = Occupancy.ToIndex(Piece.X, Piece.Y);
+
+    for (int32 OpIndex = Segment.RayBegin; OpIndex < Segment.RayEnd; OpIndex++)
+    {
+        const FRayOp& Op = Rays[OpIndex];
+        const FChessGridStep& Offset = ChessGridSteps::Directions[static_cast<int32>(Op.Dir)];
+        const int32 Step = Tables.GetRayStep(Op.Dir);
+        const int32 Length = FMath::Min(Tables.GetRayLength(Origin, Op.Dir), Op.bRangeFromPiece ? Piece.MovementRange : Op.MaxRange);
+
+        int32 Square = Origin;
+        for (int32 i = 1; i <= Length; i++)
+        {
+            Square += Step;
+
+            // Add all tiles in range (including empty ones), stopping at the first piece
+            OutTiles.Emplace(Piece.X + Offset.X * i, Piece.Y + Offset.Y * i);
+            if (Occupancy.IsOccupied(Square))
+            {
+                break;
+            }
+        }
+    }
+
+    for (int32 LeapIndex = Segment.LeapBegin; LeapIndex < Segment.LeapEnd; LeapIndex++)
+    {
+        const int32 TargetX = Piece.X + Leaps[LeapIndex].X;
+        const int32 TargetY = Piece.Y + Leaps[LeapIndex].Y;
+        if (Occupancy.IsInside(TargetX, TargetY))
+        {
+            OutTiles.Emplace(TargetX, TargetY);
+        }
+    }
+}
@@ -0,0 +1,143 @@
+// ChessMovement.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessBitboard.h"
+#include "ChessMoveTables.h"
+
+struct FChessPieceState;
+enum class EChessPieceKind : uint8;
+
+// Bit per EChessDirection
+namespace EChessDirectionMask
+{
+    constexpr uint8 Orthogonal = 0x0F;
+    constexpr uint8 Diagonal = 0xF0;
+    constexpr uint8 All = 0xFF;
+}
+
+enum class EChessRayBlocking : uint8
+{
+    Stop,       // A piece ends the ray
+    PassOver    // Moves keep sliding past pieces (rook and bishop style)
+};
+
+struct FChessRayRule
+{
+    // Bit per EChessDirection, walked in enum order
+    uint8 Directions = 0;
+
+    // Tiles along each direction; 0 reaches the edge of the board
+    int32 MaxRange = 0;
+
+    // Use the piece's MovementRange instead of MaxRange
+    bool bRangeFromPiece = false;
+
+    // Only used for moves; attacks and ranges always end at the first piece
+    EChessRayBlocking Blocking = EChessRayBlocking::Stop;
+};
+
+struct FChessRuleSet
+{
+    TArray<FChessRayRule> Rays;
+
+    // Jump offsets, in output order
+    TArray<FIntPoint> Leaps;
+};
+
+/**
+ * How a piece moves and attacks. Moves land on empty tiles, attacks on the first
+ * opponent along a ray or on a leap target, and the range is what the attack
+ * highlight shows (every tile up to and including the first piece).
+ */
+struct FChessMovementDesc
+{
+    FChessRuleSet Moves;
+    FChessRuleSet Attacks;
+
+    // Replaces Attacks while super mode is active, unless empty
+    FChessRuleSet SuperModeAttacks;
+
+    FChessRuleSet Range;
+
+    // The range is whatever Attacks returns (pieces without a separate range)
+    bool bRangeFromAttacks = false;
+
+    // In super mode, moves may also land on opponents (the player eating enemies)
+    bool bSuperModeMovesCapture = false;
+};
+
+/**
+ * A FChessMovementDesc compiled into flat per-direction ray ops and leap offsets,
+ * walked by one shared generator. Programs are interned by content and live for the
+ * whole process, so FChessPieceState can point at them from any thread.
+ */
+class DUNGEONCHESS_API FChessMovementProgram
+{
+public:
+    // Compiles Desc, or returns the existing program with the same content
+    static const FChessMovementProgram* Intern(const FChessMovementDesc& Desc);
+
+    // Program interned under HashKey, or null if nothing with that content was compiled yet
+    static const FChessMovementProgram* Find(uint64 HashKey);
+
+    // Programs for the built-in piece kinds (empty for Custom)
+    static const FChessMovementProgram& GetBuiltIn(EChessPieceKind Kind);
+
+    // Each resets OutTiles and reads only occupancy and the move tables
+    void GatherMoves(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const;
+    void GatherAttacks(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const;
+    void GatherRange(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const;
+
+    // Every tile GatherAttacks looks at: up to and including the first piece on each ray, every leap target
+    void GatherAttackScan(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const;
+
+    // Every tile whose occupancy GatherRange reads; a superset of the range when it comes from the attacks
+    void GatherRangeScan(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const;
+
+    // Content hash, stable between runs; folded into the Zobrist key of custom pieces
+    FORCEINLINE uint64 GetHashKey() const { return HashKey; }
+
+private:
+    enum ESet : uint8
+    {
+        SetMoves,
+        SetAttacks,
+        SetSuperModeAttacks,
+        SetRange,
+        NumSets
+    };
+
+    struct FRayOp
+    {
+        EChessDirection Dir = EChessDirection::PlusX;
+        bool bPassOver = false;
+        bool bRangeFromPiece = false;
+        int32 MaxRange = MAX_int32;
+    };
+
+    struct FSegment
+    {
+        int32 RayBegin = 0;
+        int32 RayEnd = 0;
+        int32 LeapBegin = 0;
+        int32 LeapEnd = 0;
+    };
+
+    void Compile(const FChessMovementDesc& Desc);
+    void CompileSet(ESet Set, const FChessRuleSet& Rules);
+
+    const FSegment& GetAttackSegment(const FChessPieceState& Piece) const;
+
+    // Every tile up to and including the first piece on each ray, and every on-board leap target
+    void GatherSegmentRange(const FSegment& Segment, const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles) const;
+
+    TArray<FRayOp> Rays;
+    TArray<FIntPoint> Leaps;
+    FSegment Segments[NumSets];
+
+    bool bRangeFromAttacks = false;
+    bool bSuperModeMovesCapture = false;
+
+    uint64 HashKey = 0;
+};
@@ -0,0 +1,71 @@
+// ChessMovementDefinition.cpp
+#include "ChessMovementDefinition.h"
+#include "ChessMovement.h"
+
+const FChessMovementProgram* UChessMovementDefinition::GetProgram() const
+{
+    if (!Program)
+    {
+        FChessMovementDesc Desc;
+        ConvertRuleSet(Moves, Desc.Moves);
+        ConvertRuleSet(Attacks, Desc.Attacks);
+        ConvertRuleSet(SuperModeAttacks, Desc.SuperModeAttacks);
+        ConvertRuleSet(AttackRange, Desc.Range);
+        Desc.bRangeFromAttacks = bRangeFromAttacks;
+        Desc.bSuperModeMovesCapture = bSuperModeMovesCapture;
+
+        Program = FChessMovementProgram::Intern(Desc);
+    }
+    return Program;
+}
+
+void UChessMovementDefinition::PostLoad()
+{
+    Super::PostLoad();
+
+    // Compile up front so the first move query of a game doesn't pay for it
+    GetProgram();
+}
+
+#if WITH_EDITOR
+void UChessMovementDefinition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Pieces pick up the new program the next time they build their rules state
+    Program = nullptr;
+}
+#endif
+
+void UChessMovementDefinition::ConvertRuleSet(const FChessRuleSetDefinition& Definition, FChessRuleSet& OutRules)
+{
+    for (const FChessRayDefinition& RayDefinition : Definition.Rays)
+    {
+        FChessRayRule& Ray = OutRules.Rays.AddDefaulted_GetRef();
+        Ray.Directions = static_cast<uint8>(RayDefinition.Directions & EChessDirectionMask::All);
+        Ray.MaxRange = RayDefinition.MaxRange;
+        Ray.bRangeFromPiece = RayDefinition.bUseMovementRange;
+        Ray.Blocking = RayDefinition.bPassOverPieces ? EChessRayBlocking::PassOver : EChessRayBlocking::Stop;
+    }
+
+    for (const FChessLeapDefinition& LeapDefinition : Definition.Leaps)
+    {
+        const FIntPoint& Offset = LeapDefinition.Offset;
+        if (!LeapDefinition.bAllOrientations)
+        {
+            OutRules.Leaps.Add(Offset);
+            continue;
+        }
+
+        const FIntPoint Orientations[] = {
+            FIntPoint(Offset.X, Offset.Y), FIntPoint(Offset.Y, Offset.X),
+            FIntPoint(-Offset.Y, Offset.X), FIntPoint(-Offset.X, Offset.Y),
+            FIntPoint(-Offset.X, -Offset.Y), FIntPoint(-Offset.Y, -Offset.X),
+            FIntPoint(Offset.Y, -Offset.X), FIntPoint(Offset.X, -Offset.Y)
+        };
+        for (const FIntPoint& Orientation : Orientations)
+        {
+            OutRules.Leaps.AddUnique(Orientation);
+        }
+    }
+}
@@ -0,0 +1,122 @@
+// ChessMovementDefinition.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ChessMovementDefinition.generated.h"
+
+class FChessMovementProgram;
+struct FChessRuleSet;
+
+// Bit per EChessDirection
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EChessDirectionFlags : uint8
+{
+    None            = 0 UMETA(Hidden),
+    PlusX           = 1 << 0,
+    MinusX          = 1 << 1,
+    PlusY           = 1 << 2,
+    MinusY          = 1 << 3,
+    PlusXPlusY      = 1 << 4,
+    MinusXMinusY    = 1 << 5,
+    PlusXMinusY     = 1 << 6,
+    MinusXPlusY     = 1 << 7
+};
+ENUM_CLASS_FLAGS(EChessDirectionFlags);
+
+USTRUCT(BlueprintType)
+struct FChessRayDefinition
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ray", meta = (Bitmask, BitmaskEnum = "/Script/DungeonChess.EChessDirectionFlags"))
+    int32 Directions = 0x0F;
+
+    // Tiles along each direction; 0 reaches the edge of the board
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ray", meta = (ClampMin = "0"))
+    int32 MaxRange = 0;
+
+    // Use the piece's MovementRange instead of MaxRange
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ray")
+    bool bUseMovementRange = false;
+
+    // Moves only: keep sliding past pieces instead of stopping at the first one
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ray")
+    bool bPassOverPieces = false;
+};
+
+USTRUCT(BlueprintType)
+struct FChessLeapDefinition
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Leap")
+    FIntPoint Offset = FIntPoint(1, 2);
+
+    // Also add every rotation and reflection of Offset (8 for a knight-style jump)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Leap")
+    bool bAllOrientations = true;
+};
+
+USTRUCT(BlueprintType)
+struct FChessRuleSetDefinition
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rules")
+    TArray<FChessRayDefinition> Rays;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rules")
+    TArray<FChessLeapDefinition> Leaps;
+};
+
+/**
+ * Movement pattern of a data-driven piece. Assign it to AChessPieceBase::MovementDefinition
+ * to give a piece new moves without code; it is compiled into a FChessMovementProgram on load
+ * and run by the same generator as the built-in pieces.
+ */
+UCLASS(BlueprintType)
+class DUNGEONCHESS_API UChessMovementDefinition : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // Empty tiles the piece can move to
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+    FChessRuleSetDefinition Moves;
+
+    // Opponents the piece can attack: the first piece along a ray, or a leap target
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+    FChessRuleSetDefinition Attacks;
+
+    // Replaces Attacks while super mode is active; leave empty to keep Attacks
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+    FChessRuleSetDefinition SuperModeAttacks;
+
+    // Tiles highlighted as the attack range, up to and including the first piece
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement", meta = (EditCondition = "!bRangeFromAttacks"))
+    FChessRuleSetDefinition AttackRange;
+
+    // Highlight only the attackable tiles instead of AttackRange
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+    bool bRangeFromAttacks = false;
+
+    // In super mode, moves may also land on opponents
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+    bool bSuperModeMovesCapture = false;
+
+    // Compiled program, built on first use if the asset was not loaded from disk
+    const FChessMovementProgram* GetProgram() const;
+
+    virtual void PostLoad() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+    static void ConvertRuleSet(const FChessRuleSetDefinition& Definition, FChessRuleSet& OutRules);
+
+    // Interned, so it outlives this asset
+    mutable const FChessMovementProgram* Program = nullptr;
+};
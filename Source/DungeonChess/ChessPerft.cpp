@@ -0,0 +1,174 @@
+// ChessPerft.cpp
+#include "ChessPerft.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    typedef void (*FGatherFunc)(const FChessOccupancy&, const FChessMoveTables&, const FChessPieceState&, FChessTileList&);
+
+    struct FGeneratorQuery
+    {
+        const TCHAR* Name;
+        FGatherFunc Gather;
+    };
+
+    const FGeneratorQuery GeneratorQueries[] = {
+        { TEXT("moves"),        &FChessRules::GatherValidMoves },
+        { TEXT("attacks"),      &FChessRules::GatherAttackTiles },
+        { TEXT("attack range"), &FChessRules::GatherAttackRangeTiles }
+    };
+}
+
+FChessPerft::FChessPerft(const FChessPerftSettings& InSettings)
+    : Settings(InSettings)
+{
+    Settings.Depth = FMath::Max(Settings.Depth, 0);
+}
+
+void FChessPerft::UseReferenceGenerators(FChessGameState& State)
+{
+    for (int32 PieceIndex = 0; PieceIndex < State.Pieces.Num(); PieceIndex++)
+    {
+        FChessPieceState& Piece = State.Pieces[PieceIndex];
+        if (!Piece.Movement)
+        {
+            Piece.Movement = &FChessRules::GetMovement(Piece);
+            State.RefreshPieceHash(PieceIndex);
+        }
+    }
+}
+
+FChessPerftResult FChessPerft::Run(const FChessGameState& Root)
+{
+    Result = FChessPerftResult();
+    Undo.Reset();
+    PlyActions.SetNum(Settings.Depth + 1);
+
+    if (!Root.Pieces.IsValidIndex(Root.PlayerIndex) || !Root.Tables.IsValid())
+    {
+        return Result;
+    }
+
+    FChessGameState State = Root;
+    if (Settings.bReferenceGenerators)
+    {
+        UseReferenceGenerators(State);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    Result.Leaves = Visit(State, Settings.Depth, false, 0);
+    Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    return Result;
+}
+
+int64 FChessPerft::Visit(FChessGameState& State, int32 Depth, bool bEnemyToMove, int32 Ply)
+{
+    Result.Nodes++;
+
+    if (Settings.bVerifyGenerators)
+    {
+        VerifyGenerators(State);
+    }
+
+    if (State.Outcome != EChessOutcome::None)
+    {
+        if (Depth > 0)
+        {
+            Result.Terminals++;
+        }
+        return Depth == 0 ? 1 : 0;
+    }
+
+    if (Depth == 0)
+    {
+        return 1;
+    }
+
+    TArray<FChessAction>& Actions = PlyActions[Ply];
+    if (bEnemyToMove)
+    {
+        FChessActions::GenerateEnemyActions(State, Actions);
+    }
+    else
+    {
+        FChessActions::GeneratePlayerActions(State, Actions);
+    }
+
+    int64 Leaves = 0;
+    for (int32 ActionIndex = 0; ActionIndex < Actions.Num(); ActionIndex++)
+    {
+        const FChessAction& Action = Actions[ActionIndex];
+        const uint64 HashBefore = State.Hash;
+
+        CountAction(Action);
+        const bool bNextEnemyToMove = FChessActions::MakeAction(State, Undo, Action, bEnemyToMove);
+        const int64 ActionLeaves = Visit(State, Depth - 1, bNextEnemyToMove, Ply + 1);
+        Undo.Pop(State);
+
+        if (Settings.bVerifyUndo && State.Hash != HashBefore)
+        {
+            Result.UndoMismatches++;
+            Mismatch(FString::Printf(TEXT("unmaking %s at ply %d changed the position hash"), *Action.ToString(), Ply));
+        }
+
+        if (Settings.bDivide && Ply == 0)
+        {
+            Result.Divide.Emplace(Action.ToString(), ActionLeaves);
+        }
+
+        Leaves += ActionLeaves;
+    }
+
+    return Leaves;
+}
+
+void FChessPerft::CountAction(const FChessAction& Action)
+{
+    switch (Action.Type)
+    {
+    case EChessActionType::Move:    Result.Moves++;    break;
+    case EChessActionType::Capture: Result.Captures++; break;
+    case EChessActionType::Clash:   Result.Clashes++;  break;
+    case EChessActionType::Eat:     Result.Eats++;     break;
+    default:                        Result.Passes++;   break;
+    }
+}
+
+void FChessPerft::VerifyGenerators(const FChessGameState& State)
+{
+    FChessTileList Reference;
+
+    for (int32 PieceIndex = 0; PieceIndex < State.Pieces.Num(); PieceIndex++)
+    {
+        const FChessPieceState& Piece = State.Pieces[PieceIndex];
+        if (!Piece.bAlive || Piece.Movement)
+        {
+            continue;
+        }
+
+        FChessPieceState ReferencePiece = Piece;
+        ReferencePiece.Movement = &FChessRules::GetMovement(Piece);
+
+        for (const FGeneratorQuery& Query : GeneratorQueries)
+        {
+            Query.Gather(State.Occupancy, *State.Tables, Piece, Scratch);
+            Query.Gather(State.Occupancy, *State.Tables, ReferencePiece, Reference);
+
+            // Same tiles in the same order; the greedy tie-breaks depend on the order
+            if (Scratch != Reference)
+            {
+                Result.GeneratorMismatches++;
+                Mismatch(FString::Printf(TEXT("%s of piece %d (kind %d) at (%d,%d): %d tiles, reference %d"),
+                    Query.Name, PieceIndex, static_cast<int32>(Piece.Kind), Piece.X, Piece.Y, Scratch.Num(), Reference.Num()));
+            }
+        }
+    }
+}
+
+void FChessPerft::Mismatch(const FString& Message)
+{
+    if (Result.FirstMismatch.IsEmpty())
+    {
+        Result.FirstMismatch = Message;
+    }
+}
@@ -0,0 +1,91 @@
+// ChessPerft.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessRules.h"
+#include "ChessActions.h"
+#include "ChessUndo.h"
+
+struct FChessPerftSettings
+{
+    // Plies to enumerate; one player action or one enemy action each
+    int32 Depth = 4;
+
+    // Generate through every piece's FChessMovementProgram instead of the specialized generators
+    bool bReferenceGenerators = false;
+
+    // At every node, compare the specialized generators against the programs for each living piece
+    bool bVerifyGenerators = false;
+
+    // Check that unmaking every action restores the position hash
+    bool bVerifyUndo = true;
+
+    // Record the leaf count below each root action
+    bool bDivide = false;
+};
+
+struct FChessPerftResult
+{
+    // Positions reached at the full depth
+    int64 Leaves = 0;
+
+    // Every position visited, root included
+    int64 Nodes = 0;
+
+    // Games that ended before the full depth
+    int64 Terminals = 0;
+
+    // Actions made, by type
+    int64 Moves = 0;
+    int64 Captures = 0;
+    int64 Clashes = 0;
+    int64 Eats = 0;
+    int64 Passes = 0;
+
+    int64 GeneratorMismatches = 0;
+    int64 UndoMismatches = 0;
+    FString FirstMismatch;
+
+    // Root action and the leaves below it, with bDivide
+    TArray<TPair<FString, int64>> Divide;
+
+    double ElapsedSeconds = 0.0;
+
+    double GetNodesPerSecond() const { return ElapsedSeconds > 0.0 ? Nodes / ElapsedSeconds : 0.0; }
+};
+
+/**
+ * Perft-style enumeration of every legal action sequence from a position, under the
+ * DungeonChess turn rules as FChessActions generates them (the same lists the enemy
+ * search walks). The golden positions in ChessPerftCommandlet pin the rules down, and running the
+ * same position with bReferenceGenerators (or bVerifyGenerators) checks optimized move
+ * generation against the straightforward movement programs.
+ *
+ * Uses make/unmake through FChessUndoStack, so the state passed to Run is left untouched.
+ */
+class DUNGEONCHESS_API FChessPerft
+{
+public:
+    explicit FChessPerft(const FChessPerftSettings& InSettings = FChessPerftSettings());
+
+    // Enumerates from Root with the player to move
+    FChessPerftResult Run(const FChessGameState& Root);
+
+    // Points every built-in piece at its FChessMovementProgram
+    static void UseReferenceGenerators(FChessGameState& State);
+
+private:
+    int64 Visit(FChessGameState& State, int32 Depth, bool bEnemyToMove, int32 Ply);
+
+    void CountAction(const FChessAction& Action);
+
+    void VerifyGenerators(const FChessGameState& State);
+    void Mismatch(const FString& Message);
+
+    FChessPerftSettings Settings;
+    FChessPerftResult Result;
+
+    FChessUndoStack Undo;
+    TArray<TArray<FChessAction>> PlyActions;
+    FChessTileList Scratch;
+};
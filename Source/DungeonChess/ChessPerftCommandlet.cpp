@@ -0,0 +1,311 @@
+// ChessPerftCommandlet.cpp
+#include "ChessPerftCommandlet.h"
+#include "ChessPerft.h"
+#include "ChessDistanceMap.h"
+#include "ChessSimulation.h"
+#include "DungeonChess.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    void LogResult(const TCHAR* Label, const FChessPerftResult& Result)
+    {
+        UE_LOG(LogDungeonChess, Display, TEXT("  %-9s leaves %12lld  nodes %12lld  terminal %8lld  %8.3f s  %10.0f nodes/s"),
+            Label, Result.Leaves, Result.Nodes, Result.Terminals, Result.ElapsedSeconds, Result.GetNodesPerSecond());
+    }
+
+    // The goal squares (distance 0) of each built-in enemy kind's distance map toward the player
+    // must be exactly the empty squares it could attack the player from; returns the mismatches
+    int32 CountDistanceMapMismatches(const FChessGameState& State)
+    {
+        const EChessPieceKind EnemyKinds[] = {
+            EChessPieceKind::Basic, EChessPieceKind::Rook, EChessPieceKind::Knight,
+            EChessPieceKind::Bishop, EChessPieceKind::Queen
+        };
+
+        const FChessPieceState& Player = State.Pieces[State.PlayerIndex];
+        int32 NumMismatches = 0;
+
+        for (EChessPieceKind Kind : EnemyKinds)
+        {
+            FChessPieceState Mover;
+            Mover.Kind = Kind;
+            Mover.MovementRange = 2;
+
+            FChessDistanceMap Map;
+            Map.Build(State.Occupancy, *State.Tables, Mover, Player.X, Player.Y);
+
+            int32 NumGoals = 0;
+            for (int32 Square = 0; Square < State.Occupancy.NumSquares(); Square++)
+            {
+                if (State.Occupancy.IsOccupied(Square))
+                {
+                    continue;
+                }
+
+                const FIntPoint Coord = State.Occupancy.ToCoord(Square);
+                Mover.X = Coord.X;
+                Mover.Y = Coord.Y;
+
+                const bool bCanAttack = FChessRules::CanAttackSquare(State.Occupancy, *State.Tables, Mover, Player.X, Player.Y);
+                const bool bGoal = Map.GetDistance(Square) == 0;
+                NumGoals += bGoal ? 1 : 0;
+
+                if (bCanAttack != bGoal)
+                {
+                    if (NumMismatches == 0)
+                    {
+                        UE_LOG(LogDungeonChess, Error, TEXT("  Distance map of kind %d: (%d,%d) is %s but %s attack the player"),
+                            static_cast<int32>(Kind), Coord.X, Coord.Y, bGoal ? TEXT("a goal") : TEXT("not a goal"), bCanAttack ? TEXT("can") : TEXT("cannot"));
+                    }
+                    NumMismatches++;
+                }
+            }
+
+            if (NumGoals == 0)
+            {
+                UE_LOG(LogDungeonChess, Warning, TEXT("  Distance map of kind %d has no reachable goal"), static_cast<int32>(Kind));
+            }
+        }
+
+        return NumMismatches;
+    }
+
+    bool IsSameCount(const FChessPerftResult& A, const FChessPerftResult& B)
+    {
+        return A.Leaves == B.Leaves && A.Nodes == B.Nodes && A.Terminals == B.Terminals
+            && A.Moves == B.Moves && A.Captures == B.Captures && A.Clashes == B.Clashes
+            && A.Eats == B.Eats && A.Passes == B.Passes;
+    }
+
+    FChessPieceState MakeGoldenPiece(EChessPieceKind Kind, int32 X, int32 Y, int32 MovementRange = 1)
+    {
+        FChessPieceState Piece;
+        Piece.Kind = Kind;
+        Piece.bPlayerTeam = Kind == EChessPieceKind::Player;
+        Piece.X = X;
+        Piece.Y = Y;
+        Piece.MovementRange = MovementRange;
+        return Piece;
+    }
+
+    void AddGoldenPiece(FChessGameState& State, EChessPieceKind Kind, int32 X, int32 Y, int32 MovementRange = 1)
+    {
+        State.AddPiece(MakeGoldenPiece(Kind, X, Y, MovementRange));
+    }
+
+    // Basic enemy (range 2) stopping at the player, capturing from an orthogonal neighbour only
+    void BuildGoldenBasic(FChessGameState& State)
+    {
+        State.Init(5, 5);
+        AddGoldenPiece(State, EChessPieceKind::Player, 0, 0);
+        AddGoldenPiece(State, EChessPieceKind::Basic, 2, 0, 2);
+    }
+
+    // Rook sliding past the knight on its file, capturing along its rank; knight leaping
+    void BuildGoldenRookKnight(FChessGameState& State)
+    {
+        State.Init(5, 5);
+        AddGoldenPiece(State, EChessPieceKind::Player, 0, 0);
+        AddGoldenPiece(State, EChessPieceKind::Rook, 3, 1);
+        AddGoldenPiece(State, EChessPieceKind::Knight, 3, 3);
+    }
+
+    // Bishop capturing two diagonal steps away; queen moving four tiles but attacking only three
+    void BuildGoldenBishopQueen(FChessGameState& State)
+    {
+        State.Init(5, 5);
+        AddGoldenPiece(State, EChessPieceKind::Player, 0, 0);
+        AddGoldenPiece(State, EChessPieceKind::Bishop, 2, 3);
+        AddGoldenPiece(State, EChessPieceKind::Queen, 4, 0);
+    }
+
+    // Player in super mode next to the last enemy: clash, or eat it and win; an ExtraMove lets the player go again
+    void BuildGoldenSuperMode(FChessGameState& State)
+    {
+        State.Init(5, 5);
+        FChessPieceState Player = MakeGoldenPiece(EChessPieceKind::Player, 1, 1);
+        FChessRules::ActivateSuperMode(Player, 2);
+        State.AddPiece(Player);
+        AddGoldenPiece(State, EChessPieceKind::Knight, 2, 2);
+
+        FChessPowerUpState ExtraMove;
+        ExtraMove.Kind = EChessPowerUpKind::ExtraMove;
+        State.SetPowerUp(0, 2, ExtraMove);
+    }
+
+    struct FGoldenCase
+    {
+        const TCHAR* Name;
+        void (*Build)(FChessGameState&);
+        int32 Depth;
+
+        // Leaves, nodes, terminals, then moves, captures, clashes, eats and passes made
+        int64 Counts[8];
+    };
+
+    // Counted by hand from the turn rules as the piece actors played them before the rules core
+    // existed, so they check both the specialized generators and the movement programs
+    const FGoldenCase GoldenCases[] = {
+        { TEXT("Basic"),        &BuildGoldenBasic,       2, { 18, 23, 0, 20, 1, 0, 0, 1 } },
+        { TEXT("RookKnight"),   &BuildGoldenRookKnight,  2, { 32, 37, 0, 33, 2, 0, 0, 1 } },
+        { TEXT("BishopQueen"),  &BuildGoldenBishopQueen, 2, { 55, 60, 0, 56, 2, 0, 0, 1 } },
+        { TEXT("SuperMode"),    &BuildGoldenSuperMode,   2, { 56, 67, 1, 60, 2, 1, 1, 2 } }
+    };
+
+    // Runs every golden case with both generator sets; returns the number of failed runs
+    int32 RunGoldenCases(bool bVerifyGenerators)
+    {
+        int32 NumFailed = 0;
+
+        for (const FGoldenCase& Case : GoldenCases)
+        {
+            FChessGameState State;
+            Case.Build(State);
+            FChessRules::StartTurn(State);
+
+            FChessPerftResult Expected;
+            Expected.Leaves = Case.Counts[0];
+            Expected.Nodes = Case.Counts[1];
+            Expected.Terminals = Case.Counts[2];
+            Expected.Moves = Case.Counts[3];
+            Expected.Captures = Case.Counts[4];
+            Expected.Clashes = Case.Counts[5];
+            Expected.Eats = Case.Counts[6];
+            Expected.Passes = Case.Counts[7];
+
+            for (int32 Reference = 0; Reference < 2; Reference++)
+            {
+                FChessPerftSettings Settings;
+                Settings.Depth = Case.Depth;
+                Settings.bReferenceGenerators = Reference != 0;
+                Settings.bVerifyGenerators = bVerifyGenerators;
+
+                FChessPerft Perft(Settings);
+                const FChessPerftResult Result = Perft.Run(State);
+
+                const bool bPassed = IsSameCount(Result, Expected) && Result.GeneratorMismatches == 0 && Result.UndoMismatches == 0;
+                UE_LOG(LogDungeonChess, Display, TEXT("  Golden %-12s %-9s depth %d  leaves %lld/%lld  nodes %lld/%lld  %s"),
+                    Case.Name, Reference != 0 ? TEXT("reference") : TEXT("optimized"), Case.Depth,
+                    Result.Leaves, Expected.Leaves, Result.Nodes, Expected.Nodes, bPassed ? TEXT("ok") : TEXT("FAILED"));
+
+                if (!bPassed)
+                {
+                    UE_LOG(LogDungeonChess, Error, TEXT("    moves %lld/%lld captures %lld/%lld clashes %lld/%lld eats %lld/%lld passes %lld/%lld terminals %lld/%lld %s"),
+                        Result.Moves, Expected.Moves, Result.Captures, Expected.Captures, Result.Clashes, Expected.Clashes,
+                        Result.Eats, Expected.Eats, Result.Passes, Expected.Passes, Result.Terminals, Expected.Terminals, *Result.FirstMismatch);
+                    NumFailed++;
+                }
+            }
+        }
+
+        return NumFailed;
+    }
+}
+
+UChessPerftCommandlet::UChessPerftCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UChessPerftCommandlet::Main(const FString& Params)
+{
+    FString LevelName = TEXT("Level_One");
+    FParse::Value(*Params, TEXT("Level="), LevelName);
+
+    FChessSimulationConfig Config = FChessSimulationConfig::ForLevel(LevelName);
+
+    int32 NumPositions = 8;
+    int32 Seed = 0;
+
+    FChessPerftSettings Settings;
+    FParse::Value(*Params, TEXT("Depth="), Settings.Depth);
+    FParse::Value(*Params, TEXT("Positions="), NumPositions);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Enemies="), Config.NumEnemies);
+    FParse::Value(*Params, TEXT("Width="), Config.BoardWidth);
+    FParse::Value(*Params, TEXT("Height="), Config.BoardHeight);
+    Settings.bVerifyGenerators = FParse::Param(*Params, TEXT("Verify"));
+    Settings.bDivide = FParse::Param(*Params, TEXT("Divide"));
+    const bool bReference = !FParse::Param(*Params, TEXT("NoReference"));
+
+    if (NumPositions <= 0 || Settings.Depth <= 0 || Config.BoardWidth <= 0 || Config.BoardHeight <= 0)
+    {
+        UE_LOG(LogDungeonChess, Error, TEXT("ChessPerft: need -Positions > 0, -Depth > 0 and a non-empty board"));
+        return 1;
+    }
+
+    UE_LOG(LogDungeonChess, Display, TEXT("ChessPerft: %d positions from seed %d, depth %d, %dx%d, %d enemies%s"),
+        NumPositions, Seed, Settings.Depth, Config.BoardWidth, Config.BoardHeight, Config.NumEnemies,
+        Settings.bVerifyGenerators ? TEXT(", verifying generators") : TEXT(""));
+
+    // Fixed positions with known counts first; the seeded ones below only compare the generators with each other
+    const int32 GoldenFailed = RunGoldenCases(Settings.bVerifyGenerators);
+
+    int32 NumFailed = 0;
+    int64 TotalNodes = 0;
+    double TotalSeconds = 0.0;
+
+    for (int32 Position = 0; Position < NumPositions; Position++)
+    {
+        // Position i is always the start of the simulated game with seed Seed + i
+        FRandomStream Random(Seed + Position);
+        FChessGameState State;
+        FChessSimulation::SetupGame(Config, Random, State);
+        FChessRules::StartTurn(State);
+
+        UE_LOG(LogDungeonChess, Display, TEXT("Position %d (seed %d, hash %016llx)"), Position, Seed + Position, State.Hash);
+
+        FChessPerft Perft(Settings);
+        const FChessPerftResult Result = Perft.Run(State);
+        LogResult(TEXT("Optimized"), Result);
+        TotalNodes += Result.Nodes;
+        TotalSeconds += Result.ElapsedSeconds;
+
+        for (const TPair<FString, int64>& Entry : Result.Divide)
+        {
+            UE_LOG(LogDungeonChess, Display, TEXT("    %-24s %lld"), *Entry.Key, Entry.Value);
+        }
+
+        bool bFailed = Result.GeneratorMismatches > 0 || Result.UndoMismatches > 0;
+        if (bFailed)
+        {
+            UE_LOG(LogDungeonChess, Error, TEXT("  %lld generator and %lld undo mismatches, first: %s"),
+                Result.GeneratorMismatches, Result.UndoMismatches, *Result.FirstMismatch);
+        }
+
+        if (bReference)
+        {
+            FChessPerftSettings ReferenceSettings = Settings;
+            ReferenceSettings.bReferenceGenerators = true;
+            ReferenceSettings.bVerifyGenerators = false;
+            ReferenceSettings.bDivide = false;
+
+            FChessPerft ReferencePerft(ReferenceSettings);
+            const FChessPerftResult ReferenceResult = ReferencePerft.Run(State);
+            LogResult(TEXT("Reference"), ReferenceResult);
+
+            if (!IsSameCount(Result, ReferenceResult))
+            {
+                UE_LOG(LogDungeonChess, Error, TEXT("  Counts differ from the reference generators"));
+                bFailed = true;
+            }
+        }
+
+        const int32 DistanceMismatches = CountDistanceMapMismatches(State);
+        if (DistanceMismatches > 0)
+        {
+            UE_LOG(LogDungeonChess, Error, TEXT("  %d distance map squares disagree with the attack rules"), DistanceMismatches);
+            bFailed = true;
+        }
+
+        NumFailed += bFailed ? 1 : 0;
+    }
+
+    UE_LOG(LogDungeonChess, Display, TEXT("ChessPerft: %lld nodes in %.3f s (%.0f nodes/s), %d of %d positions passed, %d golden runs failed"),
+        TotalNodes, TotalSeconds, TotalSeconds > 0.0 ? TotalNodes / TotalSeconds : 0.0, NumPositions - NumFailed, NumPositions, GoldenFailed);
+    return NumFailed > 0 || GoldenFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,31 @@
+// ChessPerftCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ChessPerftCommandlet.generated.h"
+
+/**
+ * Checks FChessPerft against hand-counted golden positions covering every piece kind,
+ * super mode eating and ExtraMove, with both generator sets. Then runs it from fixed
+ * seeded positions (set up like FChessSimulation games) and logs leaf and node counts
+ * with nodes/sec. Each position is enumerated with the
+ * specialized generators and again with the reference movement programs; differing
+ * counts, generator mismatches or undo mismatches fail the run with a non-zero result.
+ * Each position also checks the enemy distance maps against the attack rules.
+ *
+ * UnrealEditor-Cmd DungeonChess.uproject -run=ChessPerft -Depth=4 -Positions=8
+ *
+ * Options: -Depth= -Positions= -Seed= -Level= -Enemies= -Width= -Height=
+ *          -Verify (compare generators at every node) -NoReference -Divide
+ */
+UCLASS()
+class DUNGEONCHESS_API UChessPerftCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UChessPerftCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
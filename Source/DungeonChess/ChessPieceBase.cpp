@@ -3,15 +3,17 @@
 #include "ChessTile.h"
 #include "PowerUp.h"
 #include "TurnBasedGameMode.h"
+#include "ChessWorldSubsystem.h"
+#include "ChessGameLog.h"
+#include "ChessMovementDefinition.h"
 #include "PlayerChessPiece.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "ChessDebugMessages.h"
 #include "Engine/Engine.h"
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundBase.h"
 #include "Engine/World.h"
-#include "CollisionQueryParams.h"
-#include "Engine/OverlapResult.h"
 
 AChessPieceBase::AChessPieceBase()
 {
@@ -64,11 +66,8 @@ void AChessPieceBase::Tick(float DeltaTime)
             float MoveIncrement = (MoveSpeed * DeltaTime) / Distance;
             MoveAlpha += MoveIncrement;
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 0.0f, FColor::White,
-                    FString::Printf(TEXT("Moving: Alpha=%.2f, DeltaTime=%.3f"), MoveAlpha, DeltaTime));
-            }
+            CHESS_MESSAGE(LogChessPiece, VeryVerbose, 0.0f, FColor::White,
+                TEXT("Moving: Alpha=%.2f, DeltaTime=%.3f"), MoveAlpha, DeltaTime);
 
             if (MoveAlpha >= 1.0f)
             {
@@ -96,104 +95,80 @@ void AChessPieceBase::Tick(float DeltaTime)
     }
 }
 
-TArray<FIntPoint> AChessPieceBase::GetValidMoves(AChessBoard* Board)
+FChessPieceState AChessPieceBase::GetRulesState() const
 {
-    TArray<FIntPoint> ValidMoves;
+    FChessPieceState State;
+    State.Kind = GetPieceKind();
+    State.bPlayerTeam = IsPlayerTeam();
+
+    // The player keeps its kind, which the revive rules key on
+    State.Movement = MovementDefinition ? MovementDefinition->GetProgram() : nullptr;
+    if (State.Movement && !State.bPlayerTeam)
+    {
+        State.Kind = EChessPieceKind::Custom;
+    }
+    State.X = GridX;
+    State.Y = GridY;
+    State.Health = Health;
+    State.AttackPower = AttackPower;
+    State.MovementRange = MovementRange;
+    State.bSuperModeActive = bSuperModeActive;
+    State.SuperModeMovesRemaining = SuperModeMovesRemaining;
+    State.bHasActedThisTurn = bHasActedThisTurn;
+    State.bAlive = !IsActorBeingDestroyed();
+    return State;
+}
 
-    if (!Board)
+void AChessPieceBase::ApplyRulesState(const FChessPieceState& State)
+{
+    // Stats only - grid position and turn flags are driven by the actions themselves
+    Health = State.Health;
+    AttackPower = State.AttackPower;
+    bSuperModeActive = State.bSuperModeActive;
+    SuperModeMovesRemaining = State.SuperModeMovesRemaining;
+
+    // Stats are part of the position hash
+    UChessWorldSubsystem* ChessWorld = UChessWorldSubsystem::Get(this);
+    if (AChessBoard* Board = ChessWorld ? ChessWorld->GetBoard() : nullptr)
     {
-        return ValidMoves;
+        Board->RefreshSquareHash(GridX, GridY);
     }
+}
 
-    // Default: can move 1 tile in any cardinal direction
-    TArray<FIntPoint> Directions = {
-        FIntPoint(1, 0), FIntPoint(-1, 0),
-        FIntPoint(0, 1), FIntPoint(0, -1)
-    };
+void AChessPieceBase::GatherValidMoves(const AChessBoard* Board, FChessTileList& OutTiles) const
+{
+    OutTiles.Reset();
 
-    for (const FIntPoint& Dir : Directions)
+    if (!Board || !Board->IsValidPosition(GridX, GridY))
     {
-        for (int32 i = 1; i <= MovementRange; i++)
-        {
-            int32 CheckX = GridX + (Dir.X * i);
-            int32 CheckY = GridY + (Dir.Y * i);
-
-            if (Board->IsValidPosition(CheckX, CheckY))
-            {
-                AChessTile* Tile = Board->GetTileAt(CheckX, CheckY);
-                if (Tile && !Tile->OccupyingPiece)
-                {
-                    ValidMoves.Add(FIntPoint(CheckX, CheckY));
-                }
-                else
-                {
-                    // Blocked by another piece
-                    break;
-                }
-            }
-        }
+        return;
     }
 
-    return ValidMoves;
+    FChessRules::GatherValidMoves(Board->GetOccupancy(), Board->GetMoveTables(), GetRulesState(), OutTiles);
 }
 
-TArray<FIntPoint> AChessPieceBase::GetAttackTiles(AChessBoard* Board)
+void AChessPieceBase::GatherAttackTiles(const AChessBoard* Board, FChessTileList& OutTiles) const
 {
-    TArray<FIntPoint> AttackTiles;
+    OutTiles.Reset();
 
-    if (!Board)
+    if (!Board || !Board->IsValidPosition(GridX, GridY))
     {
-        return AttackTiles;
+        return;
     }
 
-    // Choose directions based on super mode
-    TArray<FIntPoint> Directions;
-    if (bSuperModeActive)
-    {
-        // All 8 directions in super mode
-        Directions = {
-            FIntPoint(1, 0), FIntPoint(-1, 0),
-            FIntPoint(0, 1), FIntPoint(0, -1),
-            FIntPoint(1, 1), FIntPoint(1, -1),
-            FIntPoint(-1, 1), FIntPoint(-1, -1)
-        };
-    }
-    else
-    {
-        // Normal - only 4 cardinal directions
-        Directions = {
-            FIntPoint(1, 0), FIntPoint(-1, 0),
-            FIntPoint(0, 1), FIntPoint(0, -1)
-        };
-    }
+    FChessRules::GatherAttackTiles(Board->GetOccupancy(), Board->GetMoveTables(), GetRulesState(), OutTiles);
+}
 
-    for (const FIntPoint& Dir : Directions)
-    {
-        int32 CheckX = GridX + Dir.X;
-        int32 CheckY = GridY + Dir.Y;
+void AChessPieceBase::GatherAttackRangeTiles(const AChessBoard* Board, FChessTileList& OutTiles) const
+{
+    OutTiles.Reset();
 
-        if (Board->IsValidPosition(CheckX, CheckY))
-        {
-            AChessTile* Tile = Board->GetTileAt(CheckX, CheckY);
-            if (Tile && Tile->OccupyingPiece && Tile->OccupyingPiece != this)
-            {
-                // Only attack enemies, not allies
-                if (!IsAlly(Tile->OccupyingPiece))
-                {
-                    AttackTiles.Add(FIntPoint(CheckX, CheckY));
-                }
-            }
-        }
+    if (!Board || !Board->IsValidPosition(GridX, GridY))
+    {
+        return;
     }
 
-    return AttackTiles;
-}
-
-TArray<FIntPoint> AChessPieceBase::GetAttackRangeTiles(AChessBoard* Board)
-{
-    // Default implementation: return attack tiles (occupied only)
-    // Override in subclasses to show full range
-    return GetAttackTiles(Board);
+    FChessRules::GatherAttackRangeTiles(Board->GetOccupancy(), Board->GetMoveTables(), GetRulesState(), OutTiles);
 }
 
 void AChessPieceBase::MoveToPiece(int32 TargetX, int32 TargetY, AChessBoard* Board)
@@ -205,92 +180,38 @@ void AChessPieceBase::MoveToPiece(int32 TargetX, int32 TargetY, AChessBoard* Boa
 
     if (bIsMoving)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Orange, TEXT("Already moving!"));
-        }
+        CHESS_MESSAGE(LogChessPiece, Log, 3.0f, FColor::Orange, TEXT("Already moving!"));
         return;
     }
 
-    // Get old and new tiles
-    AChessTile* OldTile = Board->GetTileAt(GridX, GridY);
-    AChessTile* NewTile = Board->GetTileAt(TargetX, TargetY);
-
-    if (!NewTile || NewTile->OccupyingPiece)
+    if (!Board->IsValidPosition(TargetX, TargetY) || Board->IsOccupied(TargetX, TargetY))
     {
         return;
     }
 
-    // Update tile references
-    if (OldTile)
-    {
-        OldTile->OccupyingPiece = nullptr;
-    }
-
-    NewTile->OccupyingPiece = this;
-
-    // Check for power-ups on the target tile and collect them
-    // Use multiple methods to ensure we find power-ups
-    FVector TileLocation = NewTile->GetActorLocation();
-    
-    // Method 1: Overlap query by object type
-    TArray<FOverlapResult> OverlapResults;
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(this);
-    QueryParams.AddIgnoredActor(NewTile);
-    GetWorld()->OverlapMultiByObjectType(
-        OverlapResults,
-        TileLocation,
-        FQuat::Identity,
-        FCollisionObjectQueryParams(ECC_WorldDynamic),
-        FCollisionShape::MakeSphere(100.0f), // Larger sphere to catch power-ups
-        QueryParams
-    );
-    
-    // Method 2: Also search by class directly (more reliable)
-    TArray<AActor*> FoundPowerUps;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), APowerUp::StaticClass(), FoundPowerUps);
-    
-    // Check both overlap results and found actors
-    for (const FOverlapResult& Result : OverlapResults)
-    {
-        APowerUp* PowerUp = Cast<APowerUp>(Result.GetActor());
-        if (PowerUp && IsValid(PowerUp))
-        {
-            float Distance = FVector::Dist(TileLocation, PowerUp->GetActorLocation());
-            if (Distance < 100.0f) // Within range
-            {
-                PowerUp->OnPickup(this);
-                break; // Only collect one power-up per move
-            }
-        }
-    }
-    
-    // If not found via overlap, check by distance from found actors
-    if (OverlapResults.Num() == 0 || !Cast<APowerUp>(OverlapResults[0].GetActor()))
+    UChessWorldSubsystem* ChessWorld = UChessWorldSubsystem::Get(this);
+    if (FChessGameLog* GameLog = ChessWorld ? ChessWorld->GetGameLog() : nullptr)
     {
-        for (AActor* Actor : FoundPowerUps)
-        {
-            APowerUp* PowerUp = Cast<APowerUp>(Actor);
-            if (PowerUp && IsValid(PowerUp))
-            {
-                float Distance = FVector::Dist(TileLocation, PowerUp->GetActorLocation());
-                if (Distance < 100.0f) // Within range
-                {
-                    PowerUp->OnPickup(this);
-                    break; // Only collect one power-up per move
-                }
-            }
-        }
+        GameLog->LogMove(RosterIndex, TargetX, TargetY);
     }
 
+    // Update tile references
+    Board->SetPieceAt(GridX, GridY, nullptr);
+    Board->SetPieceAt(TargetX, TargetY, this);
+
     // Update grid position
     GridX = TargetX;
     GridY = TargetY;
 
+    // Collect a power-up lying on the target tile, once the stat change re-hashes the square we stand on
+    if (APowerUp* PowerUp = Board->GetPowerUpAt(TargetX, TargetY))
+    {
+        PowerUp->OnPickup(this);
+    }
+
     // Set up smooth movement
     StartLocation = GetActorLocation();
-    // Reuse TileLocation from power-up check above
+    FVector TileLocation = Board->GetWorldLocationForTile(TargetX, TargetY);
     TargetLocation = TileLocation + FVector(25.0f, 50.0f, 0.0f); // No Z offset - pieces sit on the board 
 
     MoveAlpha = 0.0f;
@@ -301,47 +222,55 @@ void AChessPieceBase::MoveToPiece(int32 TargetX, int32 TargetY, AChessBoard* Boa
         UGameplayStatics::PlaySoundAtLocation(this, MoveSound, StartLocation);
     }
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Cyan,
-            FString::Printf(TEXT("Starting move to (%d, %d) | From: (%.1f, %.1f, %.1f) To: (%.1f, %.1f, %.1f)"),
-                TargetX, TargetY,
-                StartLocation.X, StartLocation.Y, StartLocation.Z,
-                TargetLocation.X, TargetLocation.Y, TargetLocation.Z));
-    }
+    CHESS_MESSAGE(LogChessPiece, Verbose, 3.0f, FColor::Cyan,
+        TEXT("Starting move to (%d, %d) | From: (%.1f, %.1f, %.1f) To: (%.1f, %.1f, %.1f)"),
+        TargetX, TargetY,
+        StartLocation.X, StartLocation.Y, StartLocation.Z,
+        TargetLocation.X, TargetLocation.Y, TargetLocation.Z);
 }
 
 void AChessPieceBase::OnMovementComplete()
 {
     bHasActedThisTurn = true;
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Green,
-            FString::Printf(TEXT("Arrived at (%d, %d)"), GridX, GridY));
-    }
+    CHESS_MESSAGE(LogChessPiece, Verbose, 2.0f, FColor::Green,
+        TEXT("Arrived at (%d, %d)"), GridX, GridY);
 }
 
 void AChessPieceBase::ActivateSuperMode(int32 Moves)
 {
-    bSuperModeActive = true;
-    SuperModeMovesRemaining = Moves;
+    FChessPieceState State = GetRulesState();
+    FChessRules::ActivateSuperMode(State, Moves);
+    ApplyRulesState(State);
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Magenta,
-            FString::Printf(TEXT("*** SUPER MODE! %d moves ***"), Moves));
-    }
+    CHESS_MESSAGE(LogChessPiece, Log, 5.0f, FColor::Magenta,
+        TEXT("*** SUPER MODE! %d moves ***"), Moves);
 }
 
 void AChessPieceBase::DeactivateSuperMode()
 {
-    bSuperModeActive = false;
-    SuperModeMovesRemaining = 0;
+    FChessPieceState State = GetRulesState();
+    FChessRules::DeactivateSuperMode(State);
+    ApplyRulesState(State);
 
-    if (GEngine)
+    CHESS_MESSAGE(LogChessPiece, Log, 3.0f, FColor::White, TEXT("Super Mode ended"));
+}
+
+void AChessPieceBase::ConsumeSuperModeMove()
+{
+    FChessPieceState State = GetRulesState();
+    const bool bEnded = FChessRules::ConsumeSuperModeMove(State);
+    ApplyRulesState(State);
+
+    UChessWorldSubsystem* ChessWorld = UChessWorldSubsystem::Get(this);
+    if (FChessGameLog* GameLog = ChessWorld ? ChessWorld->GetGameLog() : nullptr)
     {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::White, TEXT("Super Mode ended"));
+        GameLog->LogSuperModeSpent(RosterIndex);
+    }
+
+    if (bEnded)
+    {
+        CHESS_MESSAGE(LogChessPiece, Log, 3.0f, FColor::White, TEXT("Super Mode ended"));
     }
 }
 
@@ -357,81 +286,69 @@ void AChessPieceBase::AttackPiece(AChessPieceBase* Target)
         UGameplayStatics::PlaySoundAtLocation(this, ClashSound, GetActorLocation());
     }
 
-    // Deal damage
-    Target->Health -= AttackPower;
+    // Resolve the clash in the rules core, then write the stats back
+    const int32 Damage = AttackPower;
+    const int32 HealthAfterHit = Target->Health - Damage;
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red,
-            FString::Printf(TEXT("%s attacked %s for %d damage! Target health: %d"),
-                *GetName(), *Target->GetName(), AttackPower, Target->Health));
-    }
+    FChessPieceState AttackerState = GetRulesState();
+    FChessPieceState TargetState = Target->GetRulesState();
+    const EChessCombatResult Result = FChessRules::ResolveClash(AttackerState, TargetState);
+    ApplyRulesState(AttackerState);
+    Target->ApplyRulesState(TargetState);
 
-    // Check if target died
-    if (Target->Health <= 0)
+    UChessWorldSubsystem* ChessWorld = UChessWorldSubsystem::Get(this);
+    if (FChessGameLog* GameLog = ChessWorld ? ChessWorld->GetGameLog() : nullptr)
     {
-        // Check if target is player with revive
-        if (APlayerChessPiece* PlayerTarget = Cast<APlayerChessPiece>(Target))
+        GameLog->LogClash(RosterIndex, Target->RosterIndex, Result);
+        if (Result == EChessCombatResult::Revived)
         {
-            if (PlayerTarget->RevivesRemaining > 0) 
-            {
-                // Use one revive!
-                PlayerTarget->RevivesRemaining--;  
-                PlayerTarget->Health = 100; // Full health restoration
-
-                if (GEngine)
-                {
-                    GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green,
-                        FString::Printf(TEXT("REVIVED! %d revives remaining!"),
-                            PlayerTarget->RevivesRemaining));
-                }
-
-                // Don't destroy the player
-                bHasActedThisTurn = true;
-                return;
-            }
+            GameLog->LogRevive(Target->RosterIndex, TargetState.RevivesRemaining);
         }
+    }
 
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 4.0f, FColor::Yellow,
-                FString::Printf(TEXT("%s was defeated!"), *Target->GetName()));
-        }
+    CHESS_MESSAGE(LogChessPiece, Log, 3.0f, FColor::Red,
+        TEXT("%s attacked %s for %d damage! Target health: %d"),
+        *GetName(), *Target->GetName(), Damage, HealthAfterHit);
 
-        // Optional: steal power on kill
-        StealPower(Target);
+    if (Result == EChessCombatResult::Revived)
+    {
+        CHESS_MESSAGE(LogChessPiece, Log, 5.0f, FColor::Green,
+            TEXT("REVIVED! %d revives remaining!"), TargetState.RevivesRemaining);
 
-        // Remove from tile
-        AChessBoard* Board = nullptr;
-        TArray<AActor*> FoundActors;
-        UGameplayStatics::GetAllActorsOfClass(GetWorld(), AChessBoard::StaticClass(), FoundActors);
-        if (FoundActors.Num() > 0)
-        {
-            Board = Cast<AChessBoard>(FoundActors[0]);
-        }
+        // Don't destroy the player
+        bHasActedThisTurn = true;
+        return;
+    }
+
+    if (Result == EChessCombatResult::Killed)
+    {
+        CHESS_MESSAGE(LogChessPiece, Log, 4.0f, FColor::Yellow,
+            TEXT("%s was defeated!"), *Target->GetName());
+
+        ReportStolenPower(AttackPower - Damage);
 
+        AChessBoard* Board = ChessWorld ? ChessWorld->GetBoard() : nullptr;
+        ATurnBasedGameMode* GameMode = ChessWorld ? ChessWorld->GetGameMode() : nullptr;
+
+        // Remove from tile
         if (Board)
         {
-            AChessTile* Tile = Board->GetTileAt(Target->GridX, Target->GridY);
-            if (Tile)
-            {
-                Tile->OccupyingPiece = nullptr;
-            }
+            Board->SetPieceAt(Target->GridX, Target->GridY, nullptr);
         }
 
         // Notify game mode to refresh highlights and remove from list when enemy dies
-        ATurnBasedGameMode* GameMode = Cast<ATurnBasedGameMode>(GetWorld()->GetAuthGameMode());
         if (GameMode && Target != this && Target->PieceType != EPieceType::PlayerPawn)
         {
-            // Remove enemy from AllPieces array
-            GameMode->AllPieces.Remove(Target);
-            // Enemy is being destroyed - refresh highlights
-            GameMode->RefreshEnemyHighlights();
+            // Remove enemy from the roster and drop its attack range from the highlights
+            GameMode->RemoveEnemy(Target);
         }
 
         Target->Destroy();
         // Check to see if all the enemies are defeated
-        GameMode->CheckWinCondition();
+        if (GameMode)
+        {
+            GameMode->CheckWinCondition();
+        }
     }
 
     bHasActedThisTurn = true;
@@ -444,22 +361,17 @@ void AChessPieceBase::JumpAttackPiece(int32 TargetX, int32 TargetY, AChessBoard*
         return;
     }
 
-    AChessTile* TargetTile = Board->GetTileAt(TargetX, TargetY);
-    if (!TargetTile || !TargetTile->OccupyingPiece)
+    AChessPieceBase* Target = Board->GetPieceAt(TargetX, TargetY);
+    if (!Target)
     {
         return;
     }
 
-    AChessPieceBase* Target = TargetTile->OccupyingPiece;
-
     // Don't attack allies
     if (IsAlly(Target))
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange,
-                TEXT("Cannot attack ally!"));
-        }
+        CHESS_MESSAGE(LogChessPiece, Log, 2.0f, FColor::Orange,
+            TEXT("Cannot attack ally!"));
         return;
     }
 
@@ -469,69 +381,57 @@ void AChessPieceBase::JumpAttackPiece(int32 TargetX, int32 TargetY, AChessBoard*
         UGameplayStatics::PlaySoundAtLocation(this, AttackSound, GetActorLocation());
     }
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red,
-            FString::Printf(TEXT("Captured %s!"), *Target->GetName()));
-    }
+    CHESS_MESSAGE(LogChessPiece, Log, 3.0f, FColor::Red,
+        TEXT("Captured %s!"), *Target->GetName());
+
+    // Steal power and resolve the capture (revive check) in the rules core
+    const int32 PowerBefore = AttackPower;
+    FChessPieceState AttackerState = GetRulesState();
+    FChessPieceState TargetState = Target->GetRulesState();
+    const EChessCombatResult Result = FChessRules::ResolveCapture(AttackerState, TargetState);
+    ApplyRulesState(AttackerState);
+    Target->ApplyRulesState(TargetState);
 
-    // Get old tile
-    AChessTile* OldTile = Board->GetTileAt(GridX, GridY);
-    if (OldTile)
+    ReportStolenPower(AttackPower - PowerBefore);
+
+    UChessWorldSubsystem* ChessWorld = UChessWorldSubsystem::Get(this);
+    if (FChessGameLog* GameLog = ChessWorld ? ChessWorld->GetGameLog() : nullptr)
     {
-        OldTile->OccupyingPiece = nullptr;
+        GameLog->LogJumpCapture(RosterIndex, TargetX, TargetY, Result);
+        if (Result == EChessCombatResult::Revived)
+        {
+            GameLog->LogRevive(Target->RosterIndex, TargetState.RevivesRemaining);
+        }
     }
 
-    // Steal power and destroy target
-    StealPower(Target);
-    
     // Notify game mode to refresh highlights and remove from list when enemy dies
-    ATurnBasedGameMode* GameMode = Cast<ATurnBasedGameMode>(GetWorld()->GetAuthGameMode());
-    if (GameMode && Target != this && Target->PieceType != EPieceType::PlayerPawn)
+    ATurnBasedGameMode* GameMode = ChessWorld ? ChessWorld->GetGameMode() : nullptr;
+    const bool bTargetIsEnemy = Target != this && Target->PieceType != EPieceType::PlayerPawn;
+    if (GameMode && bTargetIsEnemy)
     {
-        // Remove enemy from AllPieces array
-        GameMode->AllPieces.Remove(Target);
-        // Enemy is being destroyed - refresh highlights
-        GameMode->RefreshEnemyHighlights();
+        // Remove enemy from the roster and drop its attack range from the highlights
+        GameMode->RemoveEnemy(Target);
     }
 
-    // Check if target is player with revive BEFORE destroying
-    bool bTargetRevived = false;
-    if (APlayerChessPiece* PlayerTarget = Cast<APlayerChessPiece>(Target))
+    if (Result == EChessCombatResult::Revived)
     {
-        if (PlayerTarget->RevivesRemaining > 0)  
-        {
-            // Use one revive!
-            PlayerTarget->RevivesRemaining--; 
-            PlayerTarget->Health = 100;
-            bTargetRevived = true;
+        // Target survived - don't capture, and stay on our own tile
+        CHESS_MESSAGE(LogChessPiece, Log, 5.0f, FColor::Green,
+            TEXT("*** REVIVED! %d revives remaining! ***"), TargetState.RevivesRemaining);
+        CHESS_MESSAGE(LogChessPiece, Log, 3.0f, FColor::Orange,
+            TEXT("Capture failed - target revived!"));
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green,
-                    FString::Printf(TEXT("*** REVIVED! %d revives remaining! ***"),
-                        PlayerTarget->RevivesRemaining));
-            }
-        }
-        else {
-            PlayerTarget->Health = 0;
-        }
+        bHasActedThisTurn = true;
+        return;
     }
 
-    if (bTargetRevived)
-    {
-        // Target survived - don't capture
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Orange,
-                TEXT("Capture failed - target revived!"));
-        }
+    // Vacate old tile
+    Board->SetPieceAt(GridX, GridY, nullptr);
 
-        bHasActedThisTurn = true;
-        return;
+    if (GameMode)
+    {
+        GameMode->CheckLoseCondition();
     }
-    
-    GameMode->CheckLoseCondition();
     Target->Destroy();
 
     // Update grid position
@@ -540,14 +440,20 @@ void AChessPieceBase::JumpAttackPiece(int32 TargetX, int32 TargetY, AChessBoard*
 
     // Start smooth movement to target position
     StartLocation = GetActorLocation();
-    FVector TileLocation = TargetTile->GetActorLocation();
+    FVector TileLocation = Board->GetWorldLocationForTile(TargetX, TargetY);
     TargetLocation = TileLocation + FVector(25.0f, 50.0f, 0.0f); // No Z offset - pieces sit on the board
 
     MoveAlpha = 0.0f;
     bIsMoving = true;
 
-    TargetTile->OccupyingPiece = this;
+    Board->SetPieceAt(TargetX, TargetY, this);
     bHasActedThisTurn = true;
+
+    // Eating the last enemy wins the game
+    if (GameMode && bTargetIsEnemy)
+    {
+        GameMode->CheckWinCondition();
+    }
 }
 
 void AChessPieceBase::StealPower(AChessPieceBase* Target)
@@ -557,16 +463,18 @@ void AChessPieceBase::StealPower(AChessPieceBase* Target)
         return;
     }
 
-    // Steal a percentage of the target's power
-    int32 StolenPower = FMath::RoundToInt(Target->AttackPower * 0.5f);
-    AttackPower += StolenPower;
+    FChessPieceState State = GetRulesState();
+    const int32 StolenPower = FChessRules::StealPower(State, Target->GetRulesState());
+    ApplyRulesState(State);
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Purple,
-            FString::Printf(TEXT("%s stole %d power! New attack: %d"),
-                *GetName(), StolenPower, AttackPower));
-    }
+    ReportStolenPower(StolenPower);
+}
+
+void AChessPieceBase::ReportStolenPower(int32 StolenPower) const
+{
+    CHESS_MESSAGE(LogChessPiece, Log, 3.0f, FColor::Purple,
+        TEXT("%s stole %d power! New attack: %d"),
+        *GetName(), StolenPower, AttackPower);
 }
 
 bool AChessPieceBase::IsAlly(AChessPieceBase* OtherPiece) const
@@ -577,11 +485,20 @@ bool AChessPieceBase::IsAlly(AChessPieceBase* OtherPiece) const
     }
 
     // Player pieces are allies to each other, enemy pieces are allies to each other
-    bool bThisIsPlayer = (PieceType == EPieceType::PlayerPawn);
-    bool bOtherIsPlayer = (OtherPiece->PieceType == EPieceType::PlayerPawn);
+    return FChessRules::IsAlly(GetRulesState(), OtherPiece->GetRulesState());
+}
 
-    // They are allies if they are both players or both enemies
-    return (bThisIsPlayer && bOtherIsPlayer) || (!bThisIsPlayer && !bOtherIsPlayer);
+void AChessPieceBase::SnapToTile(AChessBoard* Board, int32 TargetX, int32 TargetY)
+{
+    GridX = TargetX;
+    GridY = TargetY;
+    bIsMoving = false;
+
+    if (Board)
+    {
+        TargetLocation = Board->GetWorldLocationForTile(TargetX, TargetY) + FVector(25.0f, 50.0f, 0.0f);
+        SetActorLocation(TargetLocation);
+    }
 }
 
 void AChessPieceBase::OnTurnStart()
@@ -592,4 +509,4 @@ void AChessPieceBase::OnTurnStart()
 void AChessPieceBase::OnTurnEnd()
 {
     // Override in subclasses if needed
-}
\ No newline at end of file
+}
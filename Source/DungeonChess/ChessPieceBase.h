@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "ChessRules.h"
 #include "ChessPieceBase.generated.h"
 
 UENUM(BlueprintType)
@@ -41,6 +42,8 @@ protected:
     // Called when smooth movement completes
     virtual void OnMovementComplete();
 
+    void ReportStolenPower(int32 StolenPower) const;
+
 public:
     AChessPieceBase();
 
@@ -56,6 +59,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
     int32 MovementRange = 1;
 
+    // Data-driven movement; overrides the class's built-in pattern when set
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
+    class UChessMovementDefinition* MovementDefinition = nullptr;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio")
     class USoundBase* MoveSound;
 
@@ -69,6 +76,9 @@ public:
     int32 GridX;
     int32 GridY;
 
+    // Index in spawn order, stable for the whole game; the piece index in FChessGameState and the game log
+    int32 RosterIndex = INDEX_NONE;
+
     UPROPERTY(VisibleAnywhere)
     UStaticMeshComponent* PieceMesh;
 
@@ -85,12 +95,25 @@ public:
     void ActivateSuperMode(int32 Moves);
     void DeactivateSuperMode();
 
-    // Virtual functions for different piece behaviors
-    virtual TArray<FIntPoint> GetValidMoves(class AChessBoard* Board);
-    virtual TArray<FIntPoint> GetAttackTiles(class AChessBoard* Board);
-    
+    // Spend one super mode eat, ending super mode when none are left
+    void ConsumeSuperModeMove();
+
+    // Movement/attack pattern used by FChessRules; subclasses return their own kind
+    virtual EChessPieceKind GetPieceKind() const { return EChessPieceKind::Basic; }
+
+    // Copy of this piece's rule-relevant state, and write-back of the stats after a rules call
+    virtual FChessPieceState GetRulesState() const;
+    virtual void ApplyRulesState(const FChessPieceState& State);
+
+    // Move queries, generated by FChessRules for GetPieceKind() or the MovementDefinition.
+    // These write into a caller-owned buffer (reset on entry) and only read the board's
+    // occupancy and move tables, so they don't allocate and can run off the game thread
+    // while the board isn't being modified.
+    virtual void GatherValidMoves(const class AChessBoard* Board, FChessTileList& OutTiles) const;
+    virtual void GatherAttackTiles(const class AChessBoard* Board, FChessTileList& OutTiles) const;
+
     // Get all tiles in attack range (for highlighting - includes empty tiles)
-    virtual TArray<FIntPoint> GetAttackRangeTiles(class AChessBoard* Board);
+    virtual void GatherAttackRangeTiles(const class AChessBoard* Board, FChessTileList& OutTiles) const;
 
     // Actions
     virtual void MoveToPiece(int32 TargetX, int32 TargetY, class AChessBoard* Board);
@@ -99,12 +122,18 @@ public:
     virtual void OnTurnStart();
     virtual void OnTurnEnd();
 
+    // Places the piece on a tile instantly, cancelling any movement in progress (used by undo)
+    void SnapToTile(class AChessBoard* Board, int32 TargetX, int32 TargetY);
+
     // Stealing power mechanic
     void StealPower(AChessPieceBase* Target);
 
     // Helper function to check if a piece is an ally (same team)
     bool IsAlly(AChessPieceBase* OtherPiece) const;
 
+    // Team used by the board's occupancy bitsets (player vs enemies)
+    FORCEINLINE bool IsPlayerTeam() const { return PieceType == EPieceType::PlayerPawn; }
+
     // Override Tick function
     virtual void Tick(float DeltaTime) override;
 };
\ No newline at end of file
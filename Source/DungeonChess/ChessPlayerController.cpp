@@ -4,10 +4,12 @@
 #include "ChessBoard.h"
 #include "ChessTile.h"
 #include "TurnBasedGameMode.h"
+#include "ChessWorldSubsystem.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 #include "Kismet/GameplayStatics.h"
+#include "ChessDebugMessages.h"
 #include "Engine/Engine.h"
 
 AChessPlayerController::AChessPlayerController()
@@ -31,24 +33,15 @@ void AChessPlayerController::BeginPlay()
         {
             Subsystem->AddMappingContext(DefaultMappingContext, 0);
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TEXT("Enhanced Input Mapping Context Added"));
-            }
+            CHESS_MESSAGE(LogChessInput, Verbose, 5.0f, FColor::Green, TEXT("Enhanced Input Mapping Context Added"));
         }
         else
         {
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("DefaultMappingContext is NULL!"));
-            }
+            CHESS_MESSAGE(LogChessInput, Warning, 5.0f, FColor::Red, TEXT("DefaultMappingContext is NULL!"));
         }
     }
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan, TEXT("Chess Player Controller Initialized"));
-    }
+    CHESS_MESSAGE(LogChessInput, Verbose, 5.0f, FColor::Cyan, TEXT("Chess Player Controller Initialized"));
 }
 
 void AChessPlayerController::SetupInputComponent()
@@ -62,40 +55,35 @@ void AChessPlayerController::SetupInputComponent()
         {
             EnhancedInputComponent->BindAction(LeftClickAction, ETriggerEvent::Triggered, this, &AChessPlayerController::OnMouseClick);
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, TEXT("LeftClick Action Bound"));
-            }
+            CHESS_MESSAGE(LogChessInput, Verbose, 3.0f, FColor::Green, TEXT("LeftClick Action Bound"));
         }
 
         if (ShowMovesAction)
         {
             EnhancedInputComponent->BindAction(ShowMovesAction, ETriggerEvent::Triggered, this, &AChessPlayerController::HighlightValidMoves);
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, TEXT("ShowMoves Action Bound"));
-            }
+            CHESS_MESSAGE(LogChessInput, Verbose, 3.0f, FColor::Green, TEXT("ShowMoves Action Bound"));
         }
 
         if (ShowAttacksAction)
         {
             EnhancedInputComponent->BindAction(ShowAttacksAction, ETriggerEvent::Triggered, this, &AChessPlayerController::HighlightAttackTiles);
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, TEXT("ShowAttacks Action Bound"));
-            }
+            CHESS_MESSAGE(LogChessInput, Verbose, 3.0f, FColor::Green, TEXT("ShowAttacks Action Bound"));
         }
 
         if (EndTurnAction)
         {
             EnhancedInputComponent->BindAction(EndTurnAction, ETriggerEvent::Triggered, this, &AChessPlayerController::OnEndTurn);
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, TEXT("EndTurn Action Bound"));
-            }
+            CHESS_MESSAGE(LogChessInput, Verbose, 3.0f, FColor::Green, TEXT("EndTurn Action Bound"));
+        }
+
+        if (UndoAction)
+        {
+            EnhancedInputComponent->BindAction(UndoAction, ETriggerEvent::Triggered, this, &AChessPlayerController::OnUndo);
+
+            CHESS_MESSAGE(LogChessInput, Verbose, 3.0f, FColor::Green, TEXT("Undo Action Bound"));
         }
 
         if (OpenMenuAction)
@@ -110,10 +98,7 @@ void AChessPlayerController::SetupInputComponent()
     }
     else
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("Enhanced Input Component not found!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Warning, 5.0f, FColor::Red, TEXT("Enhanced Input Component not found!"));
     }
 }
 
@@ -121,23 +106,38 @@ void AChessPlayerController::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    // Optional: Highlight tile under cursor in real-time
+    if (!bHoverHighlight)
+    {
+        return;
+    }
+
+    AChessBoard* Board = GetBoard();
+    if (!Board)
+    {
+        return;
+    }
+
+    FIntPoint HoveredTile;
+    if (GetTileUnderCursor(HoveredTile))
+    {
+        Board->SetHoveredTile(HoveredTile.X, HoveredTile.Y);
+    }
+    else
+    {
+        Board->ClearHoveredTile();
+    }
 }
 
 void AChessPlayerController::OnMouseClick(const FInputActionValue& Value)
 {
     if (!ControlledPiece)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("No controlled piece!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Warning, 2.0f, FColor::Red, TEXT("No controlled piece!"));
         return;
     }
 
-    AChessTile* ClickedTile = GetTileUnderCursor();
-
-    if (!ClickedTile)
+    FIntPoint ClickedTile;
+    if (!GetTileUnderCursor(ClickedTile))
     {
         ClearHighlights();
         return;
@@ -146,75 +146,57 @@ void AChessPlayerController::OnMouseClick(const FInputActionValue& Value)
     // Check if we clicked a highlighted tile
     if (HighlightedTiles.Contains(ClickedTile))
     {
-        ATurnBasedGameMode* GameMode = Cast<ATurnBasedGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+        ATurnBasedGameMode* GameMode = GetChessGameMode();
 
         if (!GameMode || !GameMode->bPlayerTurn)
         {
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("Not player's turn!"));
-            }
+            CHESS_MESSAGE(LogChessInput, Log, 2.0f, FColor::Orange, TEXT("Not player's turn!"));
             return;
         }
 
         if (ControlledPiece->bHasActedThisTurn)
         {
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("Already acted!"));
-            }
+            CHESS_MESSAGE(LogChessInput, Log, 2.0f, FColor::Orange, TEXT("Already acted!"));
             return;
         }
 
         AChessBoard* Board = GameMode->GameBoard;
+        AChessPieceBase* ClickedPiece = Board ? Board->GetPieceAt(ClickedTile.X, ClickedTile.Y) : nullptr;
 
         // Super mode - eating enemies by moving into them
-        if (ControlledPiece->bSuperModeActive && ClickedTile->OccupyingPiece && bShowingMoves)
+        if (ControlledPiece->bSuperModeActive && ClickedPiece && bShowingMoves)
         {
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Magenta,
-                    FString::Printf(TEXT("EATING ENEMY! %d moves left"),
-                        ControlledPiece->SuperModeMovesRemaining - 1));
-            }
+            CHESS_MESSAGE(LogChessInput, Log, 3.0f, FColor::Magenta,
+                TEXT("EATING ENEMY! %d moves left"),
+                ControlledPiece->SuperModeMovesRemaining - 1);
 
             // Jump attack to eat the enemy
-            ControlledPiece->JumpAttackPiece(ClickedTile->GridX, ClickedTile->GridY, Board);
+            ControlledPiece->JumpAttackPiece(ClickedTile.X, ClickedTile.Y, Board);
 
             // Decrease super mode counter
-            ControlledPiece->SuperModeMovesRemaining--;
-            if (ControlledPiece->SuperModeMovesRemaining <= 0)
-            {
-                ControlledPiece->DeactivateSuperMode();
-            }
+            ControlledPiece->ConsumeSuperModeMove();
 
             ClearHighlights();
             GameMode->OnPlayerAction();
         }
         // Normal attack (diagonal clash)
-        else if (ClickedTile->OccupyingPiece && bShowingAttacks)
+        else if (ClickedPiece && bShowingAttacks)
         {
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red,
-                    FString::Printf(TEXT("Clashing with enemy at (%d, %d)!"),
-                        ClickedTile->GridX, ClickedTile->GridY));
-            }
+            CHESS_MESSAGE(LogChessInput, Log, 3.0f, FColor::Red,
+                TEXT("Clashing with enemy at (%d, %d)!"),
+                ClickedTile.X, ClickedTile.Y);
 
-            ControlledPiece->AttackPiece(ClickedTile->OccupyingPiece);
+            ControlledPiece->AttackPiece(ClickedPiece);
             ClearHighlights();
             GameMode->OnPlayerAction();
         }
         // Normal movement
-        else if (!ClickedTile->OccupyingPiece && bShowingMoves)
+        else if (!ClickedPiece && bShowingMoves)
         {
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green,
-                    FString::Printf(TEXT("Moving to (%d, %d)"), ClickedTile->GridX, ClickedTile->GridY));
-            }
+            CHESS_MESSAGE(LogChessInput, Log, 3.0f, FColor::Green,
+                TEXT("Moving to (%d, %d)"), ClickedTile.X, ClickedTile.Y);
 
-            ControlledPiece->MoveToPiece(ClickedTile->GridX, ClickedTile->GridY, Board);
+            ControlledPiece->MoveToPiece(ClickedTile.X, ClickedTile.Y, Board);
             ClearHighlights();
             GameMode->OnPlayerAction();
         }
@@ -229,135 +211,110 @@ void AChessPlayerController::HighlightValidMoves(const FInputActionValue& Value)
 {
     if (!ControlledPiece)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("No controlled piece!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Warning, 2.0f, FColor::Red, TEXT("No controlled piece!"));
         return;
     }
 
     ClearHighlights();
 
-    ATurnBasedGameMode* GameMode = Cast<ATurnBasedGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+    ATurnBasedGameMode* GameMode = GetChessGameMode();
     if (!GameMode || !GameMode->GameBoard)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("GameMode or Board not found!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Warning, 2.0f, FColor::Red, TEXT("GameMode or Board not found!"));
         return;
     }
 
     if (!GameMode->bPlayerTurn)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("Not player's turn!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Log, 2.0f, FColor::Orange, TEXT("Not player's turn!"));
         return;
     }
 
     if (ControlledPiece->bHasActedThisTurn)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("Already acted this turn!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Log, 2.0f, FColor::Orange, TEXT("Already acted this turn!"));
         return;
     }
 
-    TArray<FIntPoint> ValidMoves = ControlledPiece->GetValidMoves(GameMode->GameBoard);
+    FChessTileList ValidMoves;
+    ControlledPiece->GatherValidMoves(GameMode->GameBoard, ValidMoves);
 
     for (const FIntPoint& Move : ValidMoves)
     {
-        AChessTile* Tile = GameMode->GameBoard->GetTileAt(Move.X, Move.Y);
-        if (Tile)
-        {
-            Tile->Highlight(false);
-            HighlightedTiles.Add(Tile);
-        }
+        GameMode->GameBoard->HighlightTile(Move.X, Move.Y, false);
+        HighlightedTiles.Add(Move);
     }
 
     bShowingMoves = true;
     bShowingAttacks = false;
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green,
-            FString::Printf(TEXT("Showing %d valid moves"), ValidMoves.Num()));
-    }
+    CHESS_MESSAGE(LogChessInput, Log, 3.0f, FColor::Green,
+        TEXT("Showing %d valid moves"), ValidMoves.Num());
 }
 
 void AChessPlayerController::HighlightAttackTiles(const FInputActionValue& Value)
 {
     if (!ControlledPiece)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("No controlled piece!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Warning, 2.0f, FColor::Red, TEXT("No controlled piece!"));
         return;
     }
 
     ClearHighlights();
 
-    ATurnBasedGameMode* GameMode = Cast<ATurnBasedGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+    ATurnBasedGameMode* GameMode = GetChessGameMode();
     if (!GameMode || !GameMode->GameBoard)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("GameMode or Board not found!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Warning, 2.0f, FColor::Red, TEXT("GameMode or Board not found!"));
         return;
     }
 
     if (!GameMode->bPlayerTurn)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("Not player's turn!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Log, 2.0f, FColor::Orange, TEXT("Not player's turn!"));
         return;
     }
 
     if (ControlledPiece->bHasActedThisTurn)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("Already acted this turn!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Log, 2.0f, FColor::Orange, TEXT("Already acted this turn!"));
         return;
     }
 
-    TArray<FIntPoint> AttackTiles = ControlledPiece->GetAttackTiles(GameMode->GameBoard);
+    FChessTileList AttackTiles;
+    ControlledPiece->GatherAttackTiles(GameMode->GameBoard, AttackTiles);
 
     for (const FIntPoint& Tile : AttackTiles)
     {
-        AChessTile* ChessTile = GameMode->GameBoard->GetTileAt(Tile.X, Tile.Y);
-        if (ChessTile)
-        {
-            ChessTile->Highlight(true);
-            HighlightedTiles.Add(ChessTile);
-        }
+        GameMode->GameBoard->HighlightTile(Tile.X, Tile.Y, true);
+        HighlightedTiles.Add(Tile);
     }
 
     bShowingAttacks = true;
     bShowingMoves = false;
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red,
-            FString::Printf(TEXT("Showing %d attack tiles"), AttackTiles.Num()));
-    }
+    CHESS_MESSAGE(LogChessInput, Log, 3.0f, FColor::Red,
+        TEXT("Showing %d attack tiles"), AttackTiles.Num());
 }
 
 void AChessPlayerController::ClearHighlights()
 {
-    for (AChessTile* Tile : HighlightedTiles)
+    ATurnBasedGameMode* GameMode = GetChessGameMode();
+    AChessBoard* Board = GameMode ? GameMode->GameBoard : nullptr;
+
+    for (const FIntPoint& Tile : HighlightedTiles)
     {
-        if (Tile)
+        if (Board)
         {
-            Tile->ResetHighlight();
+            // Restore the enemy attack highlight we drew over
+            if (GameMode->IsTileUnderEnemyAttack(Tile.X, Tile.Y))
+            {
+                Board->HighlightTile(Tile.X, Tile.Y, true);
+            }
+            else
+            {
+                Board->ResetTileHighlight(Tile.X, Tile.Y);
+            }
         }
     }
 
@@ -366,40 +323,72 @@ void AChessPlayerController::ClearHighlights()
     bShowingMoves = false;
     bShowingAttacks = false;
 
-    if (Count > 0 && GEngine)
+    if (Count > 0)
     {
-        GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::White, TEXT("Highlights cleared"));
+        CHESS_MESSAGE(LogChessInput, Verbose, 1.0f, FColor::White, TEXT("Highlights cleared"));
     }
 }
 
-AChessTile* AChessPlayerController::GetTileUnderCursor()
+ATurnBasedGameMode* AChessPlayerController::GetChessGameMode() const
+{
+    UChessWorldSubsystem* ChessWorld = UChessWorldSubsystem::Get(this);
+    return ChessWorld ? ChessWorld->GetGameMode() : nullptr;
+}
+
+AChessBoard* AChessPlayerController::GetBoard() const
 {
-    FHitResult HitResult;
-    GetHitResultUnderCursor(ECC_Visibility, false, HitResult);
+    UChessWorldSubsystem* ChessWorld = UChessWorldSubsystem::Get(this);
+    return ChessWorld ? ChessWorld->GetBoard() : nullptr;
+}
+
+bool AChessPlayerController::GetTileUnderCursor(FIntPoint& OutTile)
+{
+    AChessBoard* Board = GetBoard();
+    if (!Board)
+    {
+        return false;
+    }
 
-    return Cast<AChessTile>(HitResult.GetActor());
+    // Legacy path: trace scene collision and read the grid position off the tile actor
+    if (bUsePhysicsPicking && Board->HasTileActors())
+    {
+        FHitResult HitResult;
+        GetHitResultUnderCursor(ECC_Visibility, false, HitResult);
+
+        if (AChessTile* Tile = Cast<AChessTile>(HitResult.GetActor()))
+        {
+            OutTile = FIntPoint(Tile->GridX, Tile->GridY);
+            return true;
+        }
+        return false;
+    }
+
+    // Intersect the cursor ray with the board plane and invert the tile layout - constant time,
+    // and works without tile actors or collision
+    FVector RayOrigin;
+    FVector RayDirection;
+    if (!DeprojectMousePositionToWorld(RayOrigin, RayDirection))
+    {
+        return false;
+    }
+
+    return Board->TraceTileFromRay(RayOrigin, RayDirection, OutTile);
 }
 
 void AChessPlayerController::OnEndTurn(const FInputActionValue& Value)
 {
-    ATurnBasedGameMode* GameMode = Cast<ATurnBasedGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+    ATurnBasedGameMode* GameMode = GetChessGameMode();
     if (GameMode)
     {
         if (!GameMode->bPlayerTurn)
         {
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Orange, TEXT("Not player's turn!"));
-            }
+            CHESS_MESSAGE(LogChessInput, Log, 2.0f, FColor::Orange, TEXT("Not player's turn!"));
             return;
         }
 
         ClearHighlights();
 
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 4.0f, FColor::Yellow, TEXT("===== ENDING TURN ====="));
-        }
+        CHESS_MESSAGE(LogChessInput, Log, 4.0f, FColor::Yellow, TEXT("===== ENDING TURN ====="));
 
         // Manually mark as acted to allow turn progression
         if (ControlledPiece)
@@ -411,11 +400,26 @@ void AChessPlayerController::OnEndTurn(const FInputActionValue& Value)
     }
     else
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, TEXT("GameMode not found!"));
-        }
+        CHESS_MESSAGE(LogChessInput, Warning, 2.0f, FColor::Red, TEXT("GameMode not found!"));
+    }
+}
+
+void AChessPlayerController::OnUndo(const FInputActionValue& Value)
+{
+    ATurnBasedGameMode* GameMode = GetChessGameMode();
+    if (!GameMode)
+    {
+        return;
     }
+
+    if (!GameMode->bPlayerTurn)
+    {
+        CHESS_MESSAGE(LogChessInput, Log, 2.0f, FColor::Orange, TEXT("Not player's turn!"));
+        return;
+    }
+
+    ClearHighlights();
+    GameMode->UndoLastTurn();
 }
 
 void AChessPlayerController::OpenMainMenu()
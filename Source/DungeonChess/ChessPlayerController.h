@@ -33,22 +33,35 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
     UInputAction* EndTurnAction;
 
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
+    UInputAction* UndoAction;
+
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
     UInputAction* OpenMenuAction;
 
     UPROPERTY()
     class APlayerChessPiece* ControlledPiece;
 
-    UPROPERTY()
-    TArray<class AChessTile*> HighlightedTiles;
+    // Pick tiles with a visibility trace against tile actors instead of intersecting the board plane
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+    bool bUsePhysicsPicking = false;
+
+    // Highlight the tile under the cursor every frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+    bool bHoverHighlight = true;
+
+    // Grid coordinates of the tiles currently highlighted by this controller
+    TArray<FIntPoint> HighlightedTiles;
 
     void OnMouseClick(const FInputActionValue& Value);
     void HighlightValidMoves(const FInputActionValue& Value);
     void HighlightAttackTiles(const FInputActionValue& Value);
     void OnEndTurn(const FInputActionValue& Value);
+    void OnUndo(const FInputActionValue& Value);
     void ClearHighlights();
 
-    AChessTile* GetTileUnderCursor();
+    // Grid coordinates of the tile under the mouse cursor; false if the cursor is off the board
+    bool GetTileUnderCursor(FIntPoint& OutTile);
 
     UFUNCTION()
     void OpenMainMenu();
@@ -58,6 +71,9 @@ protected:
     virtual void Tick(float DeltaTime) override;
 
 private:
+    class ATurnBasedGameMode* GetChessGameMode() const;
+    class AChessBoard* GetBoard() const;
+
     bool bShowingMoves = false;
     bool bShowingAttacks = false;
 };
\ No newline at end of file
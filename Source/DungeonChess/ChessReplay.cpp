@@ -0,0 +1,259 @@
+// ChessReplay.cpp
+#include "ChessReplay.h"
+#include "ChessMovement.h"
+
+namespace
+{
+    const TCHAR* GetEventName(EChessLogEvent Type)
+    {
+        switch (Type)
+        {
+        case EChessLogEvent::PieceSpawn:     return TEXT("PieceSpawn");
+        case EChessLogEvent::PowerUpSpawn:   return TEXT("PowerUpSpawn");
+        case EChessLogEvent::TurnStart:      return TEXT("TurnStart");
+        case EChessLogEvent::Move:           return TEXT("Move");
+        case EChessLogEvent::Clash:          return TEXT("Clash");
+        case EChessLogEvent::JumpCapture:    return TEXT("JumpCapture");
+        case EChessLogEvent::SuperModeSpent: return TEXT("SuperModeSpent");
+        case EChessLogEvent::Pickup:         return TEXT("Pickup");
+        case EChessLogEvent::Revive:         return TEXT("Revive");
+        case EChessLogEvent::EnemyChoice:    return TEXT("EnemyChoice");
+        case EChessLogEvent::Undo:           return TEXT("Undo");
+        case EChessLogEvent::GameEnd:        return TEXT("GameEnd");
+        case EChessLogEvent::PieceMovement:  return TEXT("PieceMovement");
+        default:                             return TEXT("Unknown");
+        }
+    }
+}
+
+bool FChessReplay::Load(const FString& Path, FString& OutError)
+{
+    if (!FChessGameLog::Load(Path, Header, Records, OutError))
+    {
+        return false;
+    }
+
+    NextRecord = 0;
+    NumDesyncs = 0;
+    FirstDesync.Reset();
+    TurnStates.Reset();
+    State = FChessGameState();
+    State.Init(Header.Width, Header.Height);
+    return true;
+}
+
+void FChessReplay::Run()
+{
+    while (Step())
+    {
+    }
+}
+
+FIntPoint FChessReplay::ToCoord(uint16 Square) const
+{
+    if (Square == FChessLogRecord::NoIndex || Header.Height == 0)
+    {
+        return FIntPoint(-1, -1);
+    }
+    return FIntPoint(Square / Header.Height, Square % Header.Height);
+}
+
+void FChessReplay::Desync(const FString& Message)
+{
+    if (NumDesyncs == 0)
+    {
+        FirstDesync = FString::Printf(TEXT("record %d (turn %d): %s"), NextRecord - 1, State.Turn, *Message);
+    }
+    NumDesyncs++;
+}
+
+bool FChessReplay::Step()
+{
+    if (IsFinished())
+    {
+        return false;
+    }
+
+    const FChessLogRecord& Record = Records[NextRecord++];
+    const int32 PieceIndex = Record.Piece == FChessLogRecord::NoIndex ? INDEX_NONE : Record.Piece;
+    const FIntPoint Target = ToCoord(Record.Target);
+
+    switch (Record.Type)
+    {
+    case EChessLogEvent::PieceSpawn:
+    {
+        FChessPieceState Piece;
+        Piece.Kind = static_cast<EChessPieceKind>(Record.Flags & 0x0F);
+        Piece.bPlayerTeam = (Record.Flags & 0x10) != 0;
+        Piece.X = Target.X;
+        Piece.Y = Target.Y;
+        Piece.MovementRange = Record.Param & 0xFF;
+        Piece.RevivesRemaining = Record.Param >> 8;
+        Piece.Health = Record.Value;
+        Piece.AttackPower = Record.Value2;
+
+        if (State.AddPiece(Piece) != PieceIndex)
+        {
+            Desync(FString::Printf(TEXT("piece %d spawned out of roster order"), PieceIndex));
+        }
+        break;
+    }
+
+    case EChessLogEvent::PowerUpSpawn:
+    {
+        FChessPowerUpState PowerUp;
+        PowerUp.Kind = static_cast<EChessPowerUpKind>(Record.Flags);
+        PowerUp.SuperModeMoves = Record.Value;
+        State.SetPowerUp(Target.X, Target.Y, PowerUp);
+        break;
+    }
+
+    case EChessLogEvent::TurnStart:
+    {
+        // An ExtraMove pickup only skips the enemy phase it preceded, as in RunEnemyPhase
+        State.bSkipEnemyTurn = false;
+        FChessRules::StartTurn(State);
+        if (State.Turn != Record.Value)
+        {
+            Desync(FString::Printf(TEXT("expected turn %d, replay is on turn %d"), Record.Value, State.Turn));
+            State.Turn = Record.Value;
+        }
+
+        if (static_cast<int32>(State.Hash & 0xFFFFFFFF) != Record.Value2)
+        {
+            Desync(TEXT("position hash differs at turn start"));
+        }
+
+        TurnStates.Add(State);
+        break;
+    }
+
+    case EChessLogEvent::Move:
+        if (!FChessRules::ApplyMove(State, PieceIndex, Target.X, Target.Y))
+        {
+            Desync(FString::Printf(TEXT("piece %d cannot move to (%d,%d)"), PieceIndex, Target.X, Target.Y));
+        }
+        break;
+
+    case EChessLogEvent::Clash:
+    {
+        const int32 TargetIndex = Record.Target == FChessLogRecord::NoIndex ? INDEX_NONE : Record.Target;
+        const EChessCombatResult Result = FChessRules::ApplyClash(State, PieceIndex, TargetIndex);
+        if (Result != static_cast<EChessCombatResult>(Record.Flags))
+        {
+            Desync(FString::Printf(TEXT("clash %d -> %d resolved differently"), PieceIndex, TargetIndex));
+        }
+        break;
+    }
+
+    case EChessLogEvent::JumpCapture:
+    {
+        const EChessCombatResult Result = FChessRules::ApplyJumpAttack(State, PieceIndex, Target.X, Target.Y);
+        if (Result != static_cast<EChessCombatResult>(Record.Flags))
+        {
+            Desync(FString::Printf(TEXT("capture by %d at (%d,%d) resolved differently"), PieceIndex, Target.X, Target.Y));
+        }
+        break;
+    }
+
+    case EChessLogEvent::SuperModeSpent:
+        if (State.Pieces.IsValidIndex(PieceIndex))
+        {
+            FChessRules::ConsumeSuperModeMove(State.Pieces[PieceIndex]);
+            State.RefreshPieceHash(PieceIndex);
+        }
+        break;
+
+    case EChessLogEvent::Pickup:
+        // Already applied by the move; just confirm the piece ended up on the emptied square
+        if (!State.Occupancy.IsInside(Target.X, Target.Y) || State.GetPieceIndexAt(Target.X, Target.Y) != PieceIndex
+            || State.PowerUps[State.Occupancy.ToIndex(Target.X, Target.Y)].Kind != EChessPowerUpKind::None)
+        {
+            Desync(FString::Printf(TEXT("piece %d did not pick up the power-up at (%d,%d)"), PieceIndex, Target.X, Target.Y));
+        }
+        break;
+
+    case EChessLogEvent::Revive:
+        if (!State.Pieces.IsValidIndex(PieceIndex) || State.Pieces[PieceIndex].RevivesRemaining != Record.Value)
+        {
+            Desync(FString::Printf(TEXT("piece %d should have %d revives left"), PieceIndex, Record.Value));
+        }
+        break;
+
+    case EChessLogEvent::EnemyChoice:
+        if (!State.Pieces.IsValidIndex(PieceIndex) || !State.Pieces[PieceIndex].bAlive)
+        {
+            Desync(FString::Printf(TEXT("enemy %d chosen but not on the board"), PieceIndex));
+        }
+        break;
+
+    case EChessLogEvent::Undo:
+    {
+        const int32 TurnIndex = TurnStates.FindLastByPredicate([&Record](const FChessGameState& TurnState) { return TurnState.Turn == Record.Value; });
+        if (TurnIndex == INDEX_NONE)
+        {
+            Desync(FString::Printf(TEXT("undo to unknown turn %d"), Record.Value));
+            break;
+        }
+        State = TurnStates[TurnIndex];
+        TurnStates.SetNum(TurnIndex + 1);
+        break;
+    }
+
+    case EChessLogEvent::PieceMovement:
+    {
+        const uint64 HashKey = static_cast<uint32>(Record.Value) | static_cast<uint64>(static_cast<uint32>(Record.Value2)) << 32;
+        const FChessMovementProgram* Movement = FChessMovementProgram::Find(HashKey);
+        if (!State.Pieces.IsValidIndex(PieceIndex) || !Movement)
+        {
+            Desync(FString::Printf(TEXT("movement %016llx of piece %d is not loaded"), HashKey, PieceIndex));
+            break;
+        }
+        State.Pieces[PieceIndex].Movement = Movement;
+        State.RefreshPieceHash(PieceIndex);
+        break;
+    }
+
+    case EChessLogEvent::GameEnd:
+        if (State.Outcome != static_cast<EChessOutcome>(Record.Flags))
+        {
+            Desync(TEXT("game ended with a different outcome"));
+        }
+        break;
+
+    default:
+        Desync(FString::Printf(TEXT("unknown record type %d"), static_cast<int32>(Record.Type)));
+        break;
+    }
+
+    return true;
+}
+
+FString FChessReplay::Describe(const FChessLogRecord& Record, int32 Height)
+{
+    FString Text = GetEventName(Record.Type);
+
+    if (Record.Piece != FChessLogRecord::NoIndex)
+    {
+        Text += FString::Printf(TEXT(" piece=%d"), Record.Piece);
+    }
+
+    if (Record.Target != FChessLogRecord::NoIndex)
+    {
+        if (Record.Type == EChessLogEvent::Clash)
+        {
+            Text += FString::Printf(TEXT(" target=%d"), Record.Target);
+        }
+        else if (Height > 0)
+        {
+            Text += FString::Printf(TEXT(" at=(%d,%d)"), Record.Target / Height, Record.Target % Height);
+        }
+    }
+
+    Text += FString::Printf(TEXT(" flags=%d value=%d"), Record.Flags, Record.Value);
+    if (Record.Value2 != 0)
+    {
+        Text += FString::Printf(TEXT(" value2=%d"), Record.Value2);
+    }
+    return Text;
+}
@@ -0,0 +1,57 @@
+// ChessReplay.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessRules.h"
+#include "ChessGameLog.h"
+
+/**
+ * Rebuilds a game from its FChessGameLog on a headless FChessGameState. Actions are
+ * re-applied through FChessRules; records the rules derive themselves (pickups,
+ * revives, position hashes at turn start, the outcome) are checked against the
+ * replayed state and counted as desyncs when they disagree.
+ *
+ * Step() advances one record, so a presentation layer can pace it; Run() replays
+ * the rest of the log as fast as possible.
+ */
+class DUNGEONCHESS_API FChessReplay
+{
+public:
+    bool Load(const FString& Path, FString& OutError);
+
+    // Applies the next record; false at the end of the log
+    bool Step();
+    void Run();
+
+    bool IsFinished() const { return NextRecord >= Records.Num(); }
+
+    const FChessLogHeader& GetHeader() const { return Header; }
+    const FChessGameState& GetState() const { return State; }
+    const TArray<FChessLogRecord>& GetRecords() const { return Records; }
+
+    // Record that Step() applied last
+    const FChessLogRecord* GetLastRecord() const { return NextRecord > 0 ? &Records[NextRecord - 1] : nullptr; }
+
+    int32 GetNumDesyncs() const { return NumDesyncs; }
+    const FString& GetFirstDesync() const { return FirstDesync; }
+
+    // Readable one-line form of a record, for verbose replays
+    static FString Describe(const FChessLogRecord& Record, int32 Height);
+
+private:
+    void Desync(const FString& Message);
+
+    FIntPoint ToCoord(uint16 Square) const;
+
+    FChessLogHeader Header;
+    TArray<FChessLogRecord> Records;
+    int32 NextRecord = 0;
+
+    FChessGameState State;
+
+    // State at the start of each turn seen so far, for Undo records
+    TArray<FChessGameState> TurnStates;
+
+    int32 NumDesyncs = 0;
+    FString FirstDesync;
+};
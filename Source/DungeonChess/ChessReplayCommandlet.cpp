@@ -0,0 +1,125 @@
+// ChessReplayCommandlet.cpp
+#include "ChessReplayCommandlet.h"
+#include "ChessReplay.h"
+#include "ChessMovementDefinition.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "DungeonChess.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    const TCHAR* GetOutcomeName(EChessOutcome Outcome)
+    {
+        switch (Outcome)
+        {
+        case EChessOutcome::Win:  return TEXT("Win");
+        case EChessOutcome::Lose: return TEXT("Lose");
+        default:                  return TEXT("Unfinished");
+        }
+    }
+
+    // Custom pieces are logged by program hash; compiling every definition makes those programs findable
+    int32 LoadMovementDefinitions()
+    {
+        IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+        AssetRegistry.SearchAllAssets(true);
+
+        TArray<FAssetData> Assets;
+        AssetRegistry.GetAssetsByClass(UChessMovementDefinition::StaticClass()->GetClassPathName(), Assets, true);
+
+        int32 NumLoaded = 0;
+        for (const FAssetData& Asset : Assets)
+        {
+            if (const UChessMovementDefinition* Definition = Cast<UChessMovementDefinition>(Asset.GetAsset()))
+            {
+                Definition->GetProgram();
+                NumLoaded++;
+            }
+        }
+        return NumLoaded;
+    }
+}
+
+UChessReplayCommandlet::UChessReplayCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UChessReplayCommandlet::Main(const FString& Params)
+{
+    const bool bVerbose = FParse::Param(*Params, TEXT("Verbose"));
+
+    TArray<FString> LogFiles;
+    FString LogFile;
+    FString LogDir;
+    if (FParse::Value(*Params, TEXT("Log="), LogFile))
+    {
+        LogFiles.Add(LogFile);
+    }
+    else if (FParse::Value(*Params, TEXT("Dir="), LogDir))
+    {
+        IFileManager::Get().FindFiles(LogFiles, *FPaths::Combine(LogDir, TEXT("*.dclog")), true, false);
+        for (FString& File : LogFiles)
+        {
+            File = FPaths::Combine(LogDir, File);
+        }
+    }
+
+    if (LogFiles.Num() == 0)
+    {
+        UE_LOG(LogDungeonChess, Error, TEXT("ChessReplay: need -Log=<file> or -Dir=<folder with .dclog files>"));
+        return 1;
+    }
+
+    const int32 NumDefinitions = LoadMovementDefinitions();
+    if (NumDefinitions > 0)
+    {
+        UE_LOG(LogDungeonChess, Display, TEXT("ChessReplay: %d custom movement definitions loaded"), NumDefinitions);
+    }
+
+    int32 NumFailed = 0;
+    for (const FString& File : LogFiles)
+    {
+        FChessReplay Replay;
+        FString Error;
+        if (!Replay.Load(File, Error))
+        {
+            UE_LOG(LogDungeonChess, Error, TEXT("ChessReplay: %s"), *Error);
+            NumFailed++;
+            continue;
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+        if (bVerbose)
+        {
+            while (Replay.Step())
+            {
+                UE_LOG(LogDungeonChess, Display, TEXT("  %s"), *FChessReplay::Describe(*Replay.GetLastRecord(), Replay.GetHeader().Height));
+            }
+        }
+        else
+        {
+            Replay.Run();
+        }
+        const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+        const FChessGameState& State = Replay.GetState();
+        UE_LOG(LogDungeonChess, Display, TEXT("ChessReplay: %s - seed %d, %d records, %d turns, %s, replayed in %.3f ms"),
+            *FPaths::GetCleanFilename(File), Replay.GetHeader().Seed, Replay.GetRecords().Num(), State.Turn,
+            GetOutcomeName(State.Outcome), Elapsed * 1000.0);
+
+        if (Replay.GetNumDesyncs() > 0)
+        {
+            UE_LOG(LogDungeonChess, Error, TEXT("  %d desyncs, first at %s"), Replay.GetNumDesyncs(), *Replay.GetFirstDesync());
+            NumFailed++;
+        }
+    }
+
+    UE_LOG(LogDungeonChess, Display, TEXT("ChessReplay: %d of %d logs replayed cleanly"), LogFiles.Num() - NumFailed, LogFiles.Num());
+    return NumFailed > 0 ? 1 : 0;
+}
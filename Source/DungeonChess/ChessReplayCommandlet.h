@@ -0,0 +1,26 @@
+// ChessReplayCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ChessReplayCommandlet.generated.h"
+
+/**
+ * Replays game logs written by ATurnBasedGameMode (Saved/GameLogs) headless and
+ * reports where the replayed rules disagree with the recorded game. Returns non-zero
+ * on any desync, so a folder of logs doubles as a regression suite.
+ *
+ * UnrealEditor-Cmd DungeonChess.uproject -run=ChessReplay -Log=Saved/GameLogs/Game_123.dclog
+ *
+ * Options: -Log=<file> or -Dir=<folder of .dclog files>, -Verbose to print every record
+ */
+UCLASS()
+class DUNGEONCHESS_API UChessReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UChessReplayCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,784 @@
+// ChessRules.cpp
+#include "ChessRules.h"
+#include "ChessDistanceMap.h"
+#include "ChessMovement.h"
+#include "ChessMoveGenerators.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    bool ContainsTile(const FChessTileList& Tiles, int32 X, int32 Y)
+    {
+        for (const FIntPoint& Tile : Tiles)
+        {
+            if (Tile.X == X && Tile.Y == Y)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FChessGameState
+
+void FChessGameState::Init(int32 InWidth, int32 InHeight)
+{
+    Width = FMath::Max(InWidth, 0);
+    Height = FMath::Max(InHeight, 0);
+
+    Occupancy.Init(Width, Height);
+    Tables = FChessMoveTables::Get(Width, Height);
+
+    const int32 NumSquares = Width * Height;
+    PieceAt.Init(INDEX_NONE, NumSquares);
+    PowerUps.Init(FChessPowerUpState(), NumSquares);
+
+    Zobrist = FChessZobrist::Get(NumSquares);
+    SquareHashes.Init(0, NumSquares);
+    Hash = 0;
+
+    Pieces.Reset();
+    PlayerIndex = INDEX_NONE;
+    Turn = 0;
+    bSkipEnemyTurn = false;
+    Outcome = EChessOutcome::None;
+}
+
+int32 FChessGameState::AddPiece(const FChessPieceState& Piece)
+{
+    const int32 PieceIndex = Pieces.Add(Piece);
+
+    if (Piece.bPlayerTeam && PlayerIndex == INDEX_NONE)
+    {
+        PlayerIndex = PieceIndex;
+    }
+
+    if (Piece.bAlive && Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        PlacePiece(PieceIndex, Piece.X, Piece.Y);
+    }
+
+    return PieceIndex;
+}
+
+void FChessGameState::SetPowerUp(int32 X, int32 Y, const FChessPowerUpState& PowerUp)
+{
+    if (Occupancy.IsInside(X, Y))
+    {
+        const int32 Square = Occupancy.ToIndex(X, Y);
+        PowerUps[Square] = PowerUp;
+        RefreshSquareHash(Square);
+    }
+}
+
+int32 FChessGameState::GetPieceIndexAt(int32 X, int32 Y) const
+{
+    return Occupancy.IsInside(X, Y) ? PieceAt[Occupancy.ToIndex(X, Y)] : INDEX_NONE;
+}
+
+int32 FChessGameState::GetNumLivingEnemies() const
+{
+    int32 Count = 0;
+    for (const FChessPieceState& Piece : Pieces)
+    {
+        if (Piece.bAlive && !Piece.bPlayerTeam)
+        {
+            Count++;
+        }
+    }
+    return Count;
+}
+
+void FChessGameState::PlacePiece(int32 PieceIndex, int32 X, int32 Y)
+{
+    FChessPieceState& Piece = Pieces[PieceIndex];
+    Piece.X = X;
+    Piece.Y = Y;
+
+    const int32 Square = Occupancy.ToIndex(X, Y);
+    PieceAt[Square] = PieceIndex;
+    Occupancy.Place(Square, Piece.bPlayerTeam);
+    RefreshSquareHash(Square);
+}
+
+void FChessGameState::LiftPiece(int32 PieceIndex)
+{
+    const FChessPieceState& Piece = Pieces[PieceIndex];
+    if (!Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        return;
+    }
+
+    const int32 Square = Occupancy.ToIndex(Piece.X, Piece.Y);
+    if (PieceAt[Square] == PieceIndex)
+    {
+        PieceAt[Square] = INDEX_NONE;
+        Occupancy.Remove(Square);
+        RefreshSquareHash(Square);
+    }
+}
+
+void FChessGameState::RefreshSquareHash(int32 Square)
+{
+    if (!Zobrist.IsValid() || !SquareHashes.IsValidIndex(Square))
+    {
+        return;
+    }
+
+    uint64 SquareHash = Zobrist->HashPowerUp(PowerUps[Square].Kind, Square);
+    if (PieceAt[Square] != INDEX_NONE)
+    {
+        SquareHash ^= Zobrist->HashPiece(Pieces[PieceAt[Square]], Square);
+    }
+
+    Hash ^= SquareHashes[Square] ^ SquareHash;
+    SquareHashes[Square] = SquareHash;
+}
+
+void FChessGameState::RefreshPieceHash(int32 PieceIndex)
+{
+    const FChessPieceState& Piece = Pieces[PieceIndex];
+    if (Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        RefreshSquareHash(Occupancy.ToIndex(Piece.X, Piece.Y));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Move generation
+
+const FChessMovementProgram& FChessRules::GetMovement(const FChessPieceState& Piece)
+{
+    return Piece.Movement ? *Piece.Movement : FChessMovementProgram::GetBuiltIn(Piece.Kind);
+}
+
+// Built-in kinds run their ChessMoveGen specialization, chosen once per call; pieces with a
+// movement program (custom definitions) run the program.
+
+void FChessRules::GatherValidMoves(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles)
+{
+    using namespace ChessMoveGen;
+
+    if (Piece.Movement)
+    {
+        Piece.Movement->GatherMoves(Occupancy, Tables, Piece, OutTiles);
+        return;
+    }
+
+    OutTiles.Reset();
+
+    if (!Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        return;
+    }
+
+    switch (Piece.Kind)
+    {
+    case EChessPieceKind::Basic:
+        GenerateRays<ERayMode::Moves, EChessDirectionMask::Orthogonal, PieceRange>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Player:
+        GenerateLeaps<ELeapMode::Moves, ChessGridSteps::King>(Occupancy, Piece, Piece.bSuperModeActive, OutTiles);
+        break;
+    case EChessPieceKind::Rook:
+        GenerateRays<ERayMode::MovesPassOver, EChessDirectionMask::Orthogonal, Unlimited>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Knight:
+        GenerateLeaps<ELeapMode::Moves, ChessGridSteps::Knight>(Occupancy, Piece, false, OutTiles);
+        break;
+    case EChessPieceKind::Bishop:
+        GenerateRays<ERayMode::MovesPassOver, EChessDirectionMask::Diagonal, BishopMaxRange>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Queen:
+        GenerateRays<ERayMode::Moves, EChessDirectionMask::All, QueenMaxMoveRange>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    default:
+        break;
+    }
+}
+
+void FChessRules::GatherAttackTiles(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles)
+{
+    using namespace ChessMoveGen;
+
+    if (Piece.Movement)
+    {
+        Piece.Movement->GatherAttacks(Occupancy, Tables, Piece, OutTiles);
+        return;
+    }
+
+    OutTiles.Reset();
+
+    if (!Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        return;
+    }
+
+    switch (Piece.Kind)
+    {
+    case EChessPieceKind::Basic:
+        // Adjacent tiles only: 4 cardinal directions, all 8 in super mode
+        if (Piece.bSuperModeActive)
+        {
+            GenerateRays<ERayMode::Attacks, EChessDirectionMask::All, 1>(Occupancy, Tables, Piece, OutTiles);
+        }
+        else
+        {
+            GenerateRays<ERayMode::Attacks, EChessDirectionMask::Orthogonal, 1>(Occupancy, Tables, Piece, OutTiles);
+        }
+        break;
+    case EChessPieceKind::Player:
+        GenerateLeaps<ELeapMode::Attacks, ChessGridSteps::King>(Occupancy, Piece, false, OutTiles);
+        break;
+    case EChessPieceKind::Rook:
+        GenerateRays<ERayMode::Attacks, EChessDirectionMask::Orthogonal, Unlimited>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Knight:
+        GenerateLeaps<ELeapMode::Attacks, ChessGridSteps::Knight>(Occupancy, Piece, false, OutTiles);
+        break;
+    case EChessPieceKind::Bishop:
+        GenerateRays<ERayMode::Attacks, EChessDirectionMask::Diagonal, BishopMaxRange>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Queen:
+        GenerateRays<ERayMode::Attacks, EChessDirectionMask::All, QueenMaxAttackRange>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    default:
+        break;
+    }
+}
+
+void FChessRules::GatherAttackRangeTiles(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles)
+{
+    using namespace ChessMoveGen;
+
+    if (Piece.Movement)
+    {
+        Piece.Movement->GatherRange(Occupancy, Tables, Piece, OutTiles);
+        return;
+    }
+
+    OutTiles.Reset();
+
+    if (!Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        return;
+    }
+
+    switch (Piece.Kind)
+    {
+    case EChessPieceKind::Basic:
+    case EChessPieceKind::Player:
+        // No separate range - same as the attackable tiles
+        GatherAttackTiles(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Rook:
+        GenerateRays<ERayMode::Range, EChessDirectionMask::Orthogonal, Unlimited>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Knight:
+        // Knight jumps, so every L-shaped square is in range
+        GenerateLeaps<ELeapMode::Range, ChessGridSteps::Knight>(Occupancy, Piece, false, OutTiles);
+        break;
+    case EChessPieceKind::Bishop:
+        GenerateRays<ERayMode::Range, EChessDirectionMask::Diagonal, BishopMaxRange>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Queen:
+        GenerateRays<ERayMode::Range, EChessDirectionMask::All, QueenMaxMoveRange>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    default:
+        break;
+    }
+}
+
+void FChessRules::GatherAttackScanTiles(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles)
+{
+    using namespace ChessMoveGen;
+
+    if (Piece.Movement)
+    {
+        Piece.Movement->GatherAttackScan(Occupancy, Tables, Piece, OutTiles);
+        return;
+    }
+
+    OutTiles.Reset();
+
+    if (!Occupancy.IsInside(Piece.X, Piece.Y))
+    {
+        return;
+    }
+
+    // Same patterns as GatherAttackTiles, walked in range mode
+    switch (Piece.Kind)
+    {
+    case EChessPieceKind::Basic:
+        if (Piece.bSuperModeActive)
+        {
+            GenerateRays<ERayMode::Range, EChessDirectionMask::All, 1>(Occupancy, Tables, Piece, OutTiles);
+        }
+        else
+        {
+            GenerateRays<ERayMode::Range, EChessDirectionMask::Orthogonal, 1>(Occupancy, Tables, Piece, OutTiles);
+        }
+        break;
+    case EChessPieceKind::Player:
+        GenerateLeaps<ELeapMode::Range, ChessGridSteps::King>(Occupancy, Piece, false, OutTiles);
+        break;
+    case EChessPieceKind::Rook:
+        GenerateRays<ERayMode::Range, EChessDirectionMask::Orthogonal, Unlimited>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Knight:
+        GenerateLeaps<ELeapMode::Range, ChessGridSteps::Knight>(Occupancy, Piece, false, OutTiles);
+        break;
+    case EChessPieceKind::Bishop:
+        GenerateRays<ERayMode::Range, EChessDirectionMask::Diagonal, BishopMaxRange>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    case EChessPieceKind::Queen:
+        GenerateRays<ERayMode::Range, EChessDirectionMask::All, QueenMaxAttackRange>(Occupancy, Tables, Piece, OutTiles);
+        break;
+    default:
+        break;
+    }
+}
+
+void FChessRules::GatherAttackRangeScanTiles(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles)
+{
+    if (Piece.Movement)
+    {
+        Piece.Movement->GatherRangeScan(Occupancy, Tables, Piece, OutTiles);
+        return;
+    }
+
+    switch (Piece.Kind)
+    {
+    case EChessPieceKind::Basic:
+    case EChessPieceKind::Player:
+        GatherAttackScanTiles(Occupancy, Tables, Piece, OutTiles);
+        break;
+    default:
+        // The range already holds every tile up to the first piece
+        GatherAttackRangeTiles(Occupancy, Tables, Piece, OutTiles);
+        break;
+    }
+}
+
+bool FChessRules::CanAttackSquare(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, int32 X, int32 Y)
+{
+    FChessTileList AttackTiles;
+    GatherAttackTiles(Occupancy, Tables, Piece, AttackTiles);
+    return ContainsTile(AttackTiles, X, Y);
+}
+
+// ---------------------------------------------------------------------------
+// Piece-level rules
+
+bool FChessRules::IsAlly(const FChessPieceState& A, const FChessPieceState& B)
+{
+    return A.bPlayerTeam == B.bPlayerTeam;
+}
+
+int32 FChessRules::StealPower(FChessPieceState& Attacker, const FChessPieceState& Target)
+{
+    const int32 StolenPower = FMath::RoundToInt(Target.AttackPower * 0.5f);
+    Attacker.AttackPower += StolenPower;
+    return StolenPower;
+}
+
+bool FChessRules::TryRevive(FChessPieceState& Target)
+{
+    if (Target.Kind != EChessPieceKind::Player || Target.RevivesRemaining <= 0)
+    {
+        return false;
+    }
+
+    Target.RevivesRemaining--;
+    Target.Health = ReviveHealth;
+    return true;
+}
+
+EChessCombatResult FChessRules::ResolveClash(FChessPieceState& Attacker, FChessPieceState& Target)
+{
+    Attacker.bHasActedThisTurn = true;
+
+    Target.Health -= Attacker.AttackPower;
+    if (Target.Health > 0)
+    {
+        return EChessCombatResult::Damaged;
+    }
+
+    if (TryRevive(Target))
+    {
+        return EChessCombatResult::Revived;
+    }
+
+    StealPower(Attacker, Target);
+    Target.bAlive = false;
+    return EChessCombatResult::Killed;
+}
+
+EChessCombatResult FChessRules::ResolveCapture(FChessPieceState& Attacker, FChessPieceState& Target)
+{
+    Attacker.bHasActedThisTurn = true;
+
+    // Power is stolen even when the target goes on to revive
+    StealPower(Attacker, Target);
+
+    if (Target.Kind == EChessPieceKind::Player)
+    {
+        if (TryRevive(Target))
+        {
+            return EChessCombatResult::Revived;
+        }
+        Target.Health = 0;
+    }
+
+    Target.bAlive = false;
+    return EChessCombatResult::Killed;
+}
+
+void FChessRules::ActivateSuperMode(FChessPieceState& Piece, int32 Moves)
+{
+    Piece.bSuperModeActive = true;
+    Piece.SuperModeMovesRemaining = Moves;
+}
+
+void FChessRules::DeactivateSuperMode(FChessPieceState& Piece)
+{
+    Piece.bSuperModeActive = false;
+    Piece.SuperModeMovesRemaining = 0;
+}
+
+bool FChessRules::ConsumeSuperModeMove(FChessPieceState& Piece)
+{
+    Piece.SuperModeMovesRemaining--;
+    if (Piece.SuperModeMovesRemaining <= 0)
+    {
+        DeactivateSuperMode(Piece);
+        return true;
+    }
+    return false;
+}
+
+void FChessRules::ApplyPowerUp(FChessPieceState& Piece, const FChessPowerUpState& PowerUp, bool& bOutSkipEnemyTurn)
+{
+    switch (PowerUp.Kind)
+    {
+    case EChessPowerUpKind::ExtraMove:
+        bOutSkipEnemyTurn = true;
+        break;
+
+    case EChessPowerUpKind::SuperMode:
+        ActivateSuperMode(Piece, PowerUp.SuperModeMoves);
+        break;
+
+    case EChessPowerUpKind::Revive:
+        if (Piece.Kind == EChessPieceKind::Player)
+        {
+            Piece.RevivesRemaining++;
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Game-level actions
+
+bool FChessRules::ApplyMove(FChessGameState& State, int32 PieceIndex, int32 X, int32 Y)
+{
+    if (!State.Pieces.IsValidIndex(PieceIndex) || !State.Pieces[PieceIndex].bAlive)
+    {
+        return false;
+    }
+
+    if (!State.Occupancy.IsInside(X, Y) || State.Occupancy.IsOccupied(State.Occupancy.ToIndex(X, Y)))
+    {
+        return false;
+    }
+
+    State.LiftPiece(PieceIndex);
+    State.PlacePiece(PieceIndex, X, Y);
+
+    FChessPieceState& Piece = State.Pieces[PieceIndex];
+
+    // Collect a power-up lying on the target tile
+    FChessPowerUpState& PowerUp = State.PowerUps[State.Occupancy.ToIndex(X, Y)];
+    if (PowerUp.Kind != EChessPowerUpKind::None)
+    {
+        ApplyPowerUp(Piece, PowerUp, State.bSkipEnemyTurn);
+        PowerUp = FChessPowerUpState();
+        State.RefreshPieceHash(PieceIndex);
+    }
+
+    Piece.bHasActedThisTurn = true;
+    return true;
+}
+
+EChessCombatResult FChessRules::ApplyClash(FChessGameState& State, int32 AttackerIndex, int32 TargetIndex)
+{
+    if (!State.Pieces.IsValidIndex(AttackerIndex) || !State.Pieces.IsValidIndex(TargetIndex)
+        || !State.Pieces[AttackerIndex].bAlive || !State.Pieces[TargetIndex].bAlive)
+    {
+        return EChessCombatResult::None;
+    }
+
+    const EChessCombatResult Result = ResolveClash(State.Pieces[AttackerIndex], State.Pieces[TargetIndex]);
+    State.RefreshPieceHash(AttackerIndex);
+    State.RefreshPieceHash(TargetIndex);
+    if (Result == EChessCombatResult::Killed)
+    {
+        State.LiftPiece(TargetIndex);
+        UpdateOutcome(State);
+    }
+    return Result;
+}
+
+EChessCombatResult FChessRules::ApplyJumpAttack(FChessGameState& State, int32 AttackerIndex, int32 X, int32 Y)
+{
+    if (!State.Pieces.IsValidIndex(AttackerIndex) || !State.Pieces[AttackerIndex].bAlive)
+    {
+        return EChessCombatResult::None;
+    }
+
+    const int32 TargetIndex = State.GetPieceIndexAt(X, Y);
+    if (TargetIndex == INDEX_NONE || IsAlly(State.Pieces[AttackerIndex], State.Pieces[TargetIndex]))
+    {
+        return EChessCombatResult::None;
+    }
+
+    const EChessCombatResult Result = ResolveCapture(State.Pieces[AttackerIndex], State.Pieces[TargetIndex]);
+    if (Result == EChessCombatResult::Killed)
+    {
+        // Attacker only leaves its square once the capture succeeded
+        State.LiftPiece(TargetIndex);
+        State.LiftPiece(AttackerIndex);
+        State.PlacePiece(AttackerIndex, X, Y);
+        UpdateOutcome(State);
+    }
+    else
+    {
+        State.RefreshPieceHash(AttackerIndex);
+        State.RefreshPieceHash(TargetIndex);
+    }
+    return Result;
+}
+
+EChessCombatResult FChessRules::ApplyPlayerEat(FChessGameState& State, int32 X, int32 Y)
+{
+    if (!State.Pieces.IsValidIndex(State.PlayerIndex))
+    {
+        return EChessCombatResult::None;
+    }
+
+    const EChessCombatResult Result = ApplyJumpAttack(State, State.PlayerIndex, X, Y);
+    ConsumeSuperModeMove(State.Pieces[State.PlayerIndex]);
+    State.RefreshPieceHash(State.PlayerIndex);
+    return Result;
+}
+
+// ---------------------------------------------------------------------------
+// Turn flow
+
+void FChessRules::StartTurn(FChessGameState& State)
+{
+    State.Turn++;
+    for (FChessPieceState& Piece : State.Pieces)
+    {
+        Piece.bHasActedThisTurn = false;
+    }
+}
+
+bool FChessRules::RunEnemyPhase(FChessGameState& State)
+{
+    if (State.bSkipEnemyTurn)
+    {
+        State.bSkipEnemyTurn = false;
+        return false;
+    }
+
+    if (State.Outcome != EChessOutcome::None)
+    {
+        return false;
+    }
+
+    FChessEnemyAction Action;
+    if (!ChooseGreedyEnemyAction(State, Action))
+    {
+        return false;
+    }
+
+    return ApplyEnemyAction(State, Action);
+}
+
+float FChessRules::GetGreedyEnemyScore(const FChessGameState& State, const FChessPieceState& Enemy, FChessTileList& Scratch, bool& bOutCanAttack)
+{
+    const FChessPieceState& Player = State.Pieces[State.PlayerIndex];
+
+    GatherAttackTiles(State.Occupancy, *State.Tables, Enemy, Scratch);
+    bOutCanAttack = ContainsTile(Scratch, Player.X, Player.Y);
+    if (bOutCanAttack)
+    {
+        return 1000.0f;
+    }
+
+    // Inverse distance: closer scores higher
+    const float Distance = FVector2D::Distance(FVector2D(Enemy.X, Enemy.Y), FVector2D(Player.X, Player.Y));
+    return 100.0f / (Distance + 1.0f);
+}
+
+bool FChessRules::ChooseGreedyEnemyAction(const FChessGameState& State, FChessEnemyAction& OutAction)
+{
+    FChessGreedyEnemyChooser Chooser;
+    Chooser.Begin(State);
+    Chooser.ScoreNext(State);
+    return Chooser.Finish(State, OutAction);
+}
+
+bool FChessRules::ApplyEnemyAction(FChessGameState& State, const FChessEnemyAction& Action)
+{
+    if (!State.Pieces.IsValidIndex(Action.PieceIndex))
+    {
+        return false;
+    }
+
+    if (Action.bAttack)
+    {
+        return ApplyJumpAttack(State, Action.PieceIndex, Action.Target.X, Action.Target.Y) != EChessCombatResult::None;
+    }
+
+    if (State.Occupancy.IsInside(Action.Target.X, Action.Target.Y))
+    {
+        return ApplyMove(State, Action.PieceIndex, Action.Target.X, Action.Target.Y);
+    }
+
+    return true;
+}
+
+void FChessRules::UpdateOutcome(FChessGameState& State)
+{
+    if (State.Outcome != EChessOutcome::None)
+    {
+        return;
+    }
+
+    if (!State.Pieces.IsValidIndex(State.PlayerIndex) || !State.Pieces[State.PlayerIndex].bAlive)
+    {
+        State.Outcome = EChessOutcome::Lose;
+    }
+    else if (State.GetNumLivingEnemies() == 0)
+    {
+        State.Outcome = EChessOutcome::Win;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Greedy enemy choice
+
+void FChessGreedyEnemyChooser::Begin(const FChessGameState& State)
+{
+    Candidates.Reset();
+    Scores.Reset();
+    CanAttack.Reset();
+    NextCandidate = 0;
+
+    if (!State.Pieces.IsValidIndex(State.PlayerIndex) || !State.Pieces[State.PlayerIndex].bAlive)
+    {
+        return;
+    }
+
+    for (int32 PieceIndex = 0; PieceIndex < State.Pieces.Num(); PieceIndex++)
+    {
+        const FChessPieceState& Candidate = State.Pieces[PieceIndex];
+        if (PieceIndex != State.PlayerIndex && Candidate.bAlive && !Candidate.bHasActedThisTurn)
+        {
+            Candidates.Add(PieceIndex);
+        }
+    }
+
+    Scores.SetNumUninitialized(Candidates.Num());
+    CanAttack.SetNumUninitialized(Candidates.Num());
+}
+
+bool FChessGreedyEnemyChooser::ScoreNext(const FChessGameState& State, int32 MaxCandidates)
+{
+    const int32 First = NextCandidate;
+    const int32 Count = FMath::Min(Candidates.Num() - First, FMath::Max(MaxCandidates, 1));
+    if (Count <= 0)
+    {
+        return true;
+    }
+
+    // Each worker only reads State and writes its own slot
+    ParallelFor(Count, [this, &State, First](int32 BatchIndex)
+        {
+            const int32 CandidateIndex = First + BatchIndex;
+            FChessTileList Scratch;
+            bool bCanAttack = false;
+            Scores[CandidateIndex] = FChessRules::GetGreedyEnemyScore(State, State.Pieces[Candidates[CandidateIndex]], Scratch, bCanAttack);
+            CanAttack[CandidateIndex] = bCanAttack;
+        },
+        Count < FChessRules::MinParallelGreedyCandidates ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    NextCandidate += Count;
+    return IsScored();
+}
+
+bool FChessGreedyEnemyChooser::Finish(const FChessGameState& State, FChessEnemyAction& OutAction) const
+{
+    check(IsScored());
+
+    OutAction = FChessEnemyAction();
+
+    if (Candidates.Num() == 0)
+    {
+        return false;
+    }
+
+    // Pick the best enemy that hasn't acted; the first one wins ties
+    int32 Best = 0;
+    for (int32 CandidateIndex = 1; CandidateIndex < Candidates.Num(); CandidateIndex++)
+    {
+        if (Scores[CandidateIndex] > Scores[Best])
+        {
+            Best = CandidateIndex;
+        }
+    }
+
+    const FChessPieceState& Player = State.Pieces[State.PlayerIndex];
+    const FChessPieceState& Enemy = State.Pieces[Candidates[Best]];
+    OutAction.PieceIndex = Candidates[Best];
+
+    // Attack check from scoring is reused rather than regenerated
+    if (CanAttack[Best])
+    {
+        OutAction.Target = FIntPoint(Player.X, Player.Y);
+        OutAction.bAttack = true;
+        return true;
+    }
+
+    // Move to the square fewest moves away from attacking the player, by this enemy's own
+    // movement around blockers; straight-line distance breaks ties, then the first one wins
+    FChessDistanceMapSet DistanceMaps(State);
+    const FChessDistanceMap& DistanceMap = DistanceMaps.Get(Enemy);
+
+    FChessTileList Tiles;
+    FChessRules::GatherValidMoves(State.Occupancy, *State.Tables, Enemy, Tiles);
+    int32 BestMoves = MAX_int32;
+    float BestDistance = FLT_MAX;
+    for (const FIntPoint& Move : Tiles)
+    {
+        const int32 Moves = DistanceMap.GetDistance(State.Occupancy.ToIndex(Move.X, Move.Y));
+        const float Distance = FVector2D::Distance(FVector2D(Move.X, Move.Y), FVector2D(Player.X, Player.Y));
+        if (Moves < BestMoves || (Moves == BestMoves && Distance < BestDistance))
+        {
+            BestMoves = Moves;
+            BestDistance = Distance;
+            OutAction.Target = Move;
+        }
+    }
+
+    // An enemy without moves still takes the turn, it just stays put
+    return true;
+}
@@ -0,0 +1,250 @@
+// ChessRules.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessBitboard.h"
+#include "ChessMoveTables.h"
+#include "ChessZobrist.h"
+
+class FChessMovementProgram;
+
+/**
+ * Engine-independent DungeonChess rules: plain structs for pieces and the board,
+ * and stateless functions for move generation and every turn action. No UObject
+ * or UWorld is involved, so whole games can be simulated headless. The actors
+ * (AChessPieceBase, APowerUp, ATurnBasedGameMode) delegate to these and only add
+ * presentation (sound, movement animation, highlights, messages) on top.
+ */
+
+// Movement/attack pattern of a piece. Chosen by the actor class, not by EPieceType.
+enum class EChessPieceKind : uint8
+{
+    Basic,      // AChessPieceBase: MovementRange cardinal steps, adjacent attacks
+    Player,     // King steps, eats enemies in super mode
+    Rook,
+    Knight,
+    Bishop,
+    Queen,
+    Custom      // Data-driven; FChessPieceState::Movement holds the pattern
+};
+
+// Mirrors EPowerUpType with an extra None in front
+enum class EChessPowerUpKind : uint8
+{
+    None,
+    ExtraMove,
+    SuperMode,
+    Revive
+};
+
+// Mirrors EGameResult
+enum class EChessOutcome : uint8
+{
+    None,
+    Win,
+    Lose
+};
+
+enum class EChessCombatResult : uint8
+{
+    None,       // Action was not possible
+    Damaged,    // Target survived the hit
+    Revived,    // Target would have died but used a revive
+    Killed      // Target removed from the board
+};
+
+struct FChessPieceState
+{
+    EChessPieceKind Kind = EChessPieceKind::Basic;
+    bool bPlayerTeam = false;
+
+    // Compiled pattern of Custom pieces (UChessMovementDefinition); null for the built-in kinds
+    const FChessMovementProgram* Movement = nullptr;
+
+    int32 X = 0;
+    int32 Y = 0;
+
+    int32 Health = 100;
+    int32 AttackPower = 25;
+    int32 MovementRange = 1;
+
+    bool bSuperModeActive = false;
+    int32 SuperModeMovesRemaining = 0;
+    int32 RevivesRemaining = 0;
+
+    bool bHasActedThisTurn = false;
+    bool bAlive = true;
+};
+
+struct FChessPowerUpState
+{
+    EChessPowerUpKind Kind = EChessPowerUpKind::None;
+    int32 SuperModeMoves = 5;
+};
+
+/**
+ * Complete game state for headless play. Pieces keep their index for the whole
+ * game (captured pieces are flagged, not removed), in roster order.
+ */
+struct DUNGEONCHESS_API FChessGameState
+{
+    int32 Width = 0;
+    int32 Height = 0;
+
+    TArray<FChessPieceState> Pieces;
+
+    // Piece index per square, INDEX_NONE when empty
+    TArray<int32> PieceAt;
+    TArray<FChessPowerUpState> PowerUps;
+    FChessOccupancy Occupancy;
+    TSharedPtr<const FChessMoveTables> Tables;
+
+    // Zobrist hash of pieces and power-ups, kept up to date by the board bookkeeping below.
+    // Side to move is not included; see FChessZobrist.
+    uint64 Hash = 0;
+    TArray<uint64> SquareHashes;
+    TSharedPtr<const FChessZobrist> Zobrist;
+
+    int32 PlayerIndex = INDEX_NONE;
+    int32 Turn = 0;
+    bool bSkipEnemyTurn = false;
+    EChessOutcome Outcome = EChessOutcome::None;
+
+    void Init(int32 InWidth, int32 InHeight);
+
+    // Places a piece on its square; returns its index
+    int32 AddPiece(const FChessPieceState& Piece);
+    void SetPowerUp(int32 X, int32 Y, const FChessPowerUpState& PowerUp);
+
+    int32 GetPieceIndexAt(int32 X, int32 Y) const;
+    int32 GetNumLivingEnemies() const;
+
+    // Board bookkeeping used by the rules
+    void PlacePiece(int32 PieceIndex, int32 X, int32 Y);
+    void LiftPiece(int32 PieceIndex);
+
+    // Re-hashes one square from its current occupant and power-up
+    void RefreshSquareHash(int32 Square);
+
+    // Re-hashes the square of a piece whose stats changed
+    void RefreshPieceHash(int32 PieceIndex);
+};
+
+// One enemy action as chosen by the greedy enemy policy
+struct FChessEnemyAction
+{
+    int32 PieceIndex = INDEX_NONE;
+    FIntPoint Target = FIntPoint(-1, -1);
+    bool bAttack = false;
+};
+
+class DUNGEONCHESS_API FChessRules
+{
+public:
+    static constexpr int32 ReviveHealth = 100;
+    static constexpr int32 BishopMaxRange = 4;
+    static constexpr int32 QueenMaxMoveRange = 4;
+    static constexpr int32 QueenMaxAttackRange = 3;
+
+    // Below this many candidates the greedy policy scores on the calling thread
+    static constexpr int32 MinParallelGreedyCandidates = 16;
+
+    // Move generation: compile-time specialized generators for the built-in kinds
+    // (ChessMoveGenerators.h), the FChessMovementProgram for custom pieces.
+    // Each resets OutTiles and reads only occupancy and the move tables.
+    static void GatherValidMoves(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles);
+    static void GatherAttackTiles(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles);
+
+    // Tiles in attack range for highlighting, including empty ones
+    static void GatherAttackRangeTiles(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles);
+
+    // Every tile GatherAttackTiles looks at, hostile or not: up to and including the first piece
+    // on each attack ray, and every on-board leap target
+    static void GatherAttackScanTiles(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles);
+
+    // Every tile whose occupancy the attack range depends on. For kinds whose range is their
+    // attacks (Basic, Player) that includes the empty tiles an opponent could step onto.
+    static void GatherAttackRangeScanTiles(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, FChessTileList& OutTiles);
+
+    static bool CanAttackSquare(const FChessOccupancy& Occupancy, const FChessMoveTables& Tables, const FChessPieceState& Piece, int32 X, int32 Y);
+
+    // Piece-level rules shared by the actors and the headless state
+    static bool IsAlly(const FChessPieceState& A, const FChessPieceState& B);
+
+    // Adds half the target's attack power (rounded) to the attacker; returns the amount stolen
+    static int32 StealPower(FChessPieceState& Attacker, const FChessPieceState& Target);
+
+    // Spends a revive if the target is the player and has one left
+    static bool TryRevive(FChessPieceState& Target);
+
+    // Clash (AttackPiece): damage, then revive or kill with power steal. Does not touch the board.
+    static EChessCombatResult ResolveClash(FChessPieceState& Attacker, FChessPieceState& Target);
+
+    // Capture (JumpAttackPiece): power steal first, then revive check. Does not touch the board.
+    static EChessCombatResult ResolveCapture(FChessPieceState& Attacker, FChessPieceState& Target);
+
+    static void ActivateSuperMode(FChessPieceState& Piece, int32 Moves);
+    static void DeactivateSuperMode(FChessPieceState& Piece);
+
+    // Spends one super mode eat; returns true if super mode ran out
+    static bool ConsumeSuperModeMove(FChessPieceState& Piece);
+
+    // Power-up pickup effects. ExtraMove skips the next enemy phase.
+    static void ApplyPowerUp(FChessPieceState& Piece, const FChessPowerUpState& PowerUp, bool& bOutSkipEnemyTurn);
+
+    // Game-level actions on a headless state. Each marks the acting piece as having acted.
+    static bool ApplyMove(FChessGameState& State, int32 PieceIndex, int32 X, int32 Y);
+    static EChessCombatResult ApplyClash(FChessGameState& State, int32 AttackerIndex, int32 TargetIndex);
+    static EChessCombatResult ApplyJumpAttack(FChessGameState& State, int32 AttackerIndex, int32 X, int32 Y);
+
+    // Player eating an enemy in super mode: capture plus one super mode move spent
+    static EChessCombatResult ApplyPlayerEat(FChessGameState& State, int32 X, int32 Y);
+
+    // Turn flow
+    static void StartTurn(FChessGameState& State);
+
+    // Enemy phase after the player acted: skipped by ExtraMove, otherwise one enemy acts.
+    // Returns false if the phase was skipped or no enemy could act.
+    static bool RunEnemyPhase(FChessGameState& State);
+
+    // Greedy policy: an enemy that can capture the player scores 1000, others 100 / (distance + 1).
+    // The chosen enemy captures if it can, otherwise follows its FChessDistanceMap toward the player.
+    // Candidates are scored in parallel on the read-only State once there are enough of them.
+    // Runs FChessGreedyEnemyChooser in one go.
+    static bool ChooseGreedyEnemyAction(const FChessGameState& State, FChessEnemyAction& OutAction);
+    static bool ApplyEnemyAction(FChessGameState& State, const FChessEnemyAction& Action);
+
+    static float GetGreedyEnemyScore(const FChessGameState& State, const FChessPieceState& Enemy, FChessTileList& Scratch, bool& bOutCanAttack);
+
+    static void UpdateOutcome(FChessGameState& State);
+
+    // Program describing Piece's movement; for built-in kinds the same pattern as the specialized generators
+    static const FChessMovementProgram& GetMovement(const FChessPieceState& Piece);
+};
+
+/**
+ * The greedy enemy choice in resumable steps, so a caller can spread the scoring over several
+ * frames; FChessRules::ChooseGreedyEnemyAction runs the same steps at once. State must not
+ * change between Begin and Finish.
+ */
+class DUNGEONCHESS_API FChessGreedyEnemyChooser
+{
+public:
+    // Collects the candidates: living enemies that haven't acted, none once the player is dead
+    void Begin(const FChessGameState& State);
+
+    // Scores up to MaxCandidates more candidates, in parallel once there are enough of them.
+    // Returns true when every candidate is scored.
+    bool ScoreNext(const FChessGameState& State, int32 MaxCandidates = MAX_int32);
+
+    bool IsScored() const { return NextCandidate >= Candidates.Num(); }
+
+    // Best candidate and its capture or move toward the player; false if no enemy can act
+    bool Finish(const FChessGameState& State, FChessEnemyAction& OutAction) const;
+
+private:
+    TArray<int32, TInlineAllocator<64>> Candidates;
+    TArray<float, TInlineAllocator<64>> Scores;
+    TArray<bool, TInlineAllocator<64>> CanAttack;
+    int32 NextCandidate = 0;
+};
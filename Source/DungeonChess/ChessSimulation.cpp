@@ -0,0 +1,300 @@
+// ChessSimulation.cpp
+#include "ChessSimulation.h"
+#include "ChessSpawnCells.h"
+
+namespace
+{
+    int32 ChebyshevDistance(int32 AX, int32 AY, int32 BX, int32 BY)
+    {
+        return FMath::Max(FMath::Abs(AX - BX), FMath::Abs(AY - BY));
+    }
+
+    // Player step or super mode eat onto Target, with pickup/eat bookkeeping
+    void ApplyPlayerMove(FChessGameState& State, const FIntPoint& Target, FChessSimulationResult& Result)
+    {
+        if (State.GetPieceIndexAt(Target.X, Target.Y) != INDEX_NONE)
+        {
+            if (FChessRules::ApplyPlayerEat(State, Target.X, Target.Y) == EChessCombatResult::Killed)
+            {
+                Result.EnemiesEaten++;
+            }
+            return;
+        }
+
+        const EChessPowerUpKind PowerUp = State.PowerUps[State.Occupancy.ToIndex(Target.X, Target.Y)].Kind;
+        if (FChessRules::ApplyMove(State, State.PlayerIndex, Target.X, Target.Y))
+        {
+            Result.ExtraMovesCollected += PowerUp == EChessPowerUpKind::ExtraMove ? 1 : 0;
+            Result.SuperModesCollected += PowerUp == EChessPowerUpKind::SuperMode ? 1 : 0;
+        }
+    }
+
+    void ApplyPlayerClash(FChessGameState& State, const FIntPoint& Target, FChessSimulationResult& Result)
+    {
+        const int32 TargetIndex = State.GetPieceIndexAt(Target.X, Target.Y);
+        if (FChessRules::ApplyClash(State, State.PlayerIndex, TargetIndex) == EChessCombatResult::Killed)
+        {
+            Result.EnemiesClashed++;
+        }
+    }
+}
+
+FChessSimulationConfig FChessSimulationConfig::ForLevel(const FString& LevelName)
+{
+    FChessSimulationConfig Config;
+
+    // Same split as ATurnBasedGameMode with EnemyPieceClasses = { Knight, Bishop, Queen }
+    if (LevelName.Contains(TEXT("Level_One")))
+    {
+        Config.NumEnemies = 3;
+        Config.EnemyKinds = { EChessPieceKind::Knight, EChessPieceKind::Bishop };
+    }
+    else
+    {
+        Config.NumEnemies = 1;
+        Config.EnemyKinds = { EChessPieceKind::Queen };
+    }
+
+    return Config;
+}
+
+void FChessSimulation::SetupGame(const FChessSimulationConfig& Config, FRandomStream& Random, FChessGameState& OutState)
+{
+    OutState.Init(Config.BoardWidth, Config.BoardHeight);
+
+    if (Config.BoardWidth <= 0 || Config.BoardHeight <= 0)
+    {
+        return;
+    }
+
+    // Player anywhere on the board
+    FChessPieceState Player;
+    Player.Kind = EChessPieceKind::Player;
+    Player.bPlayerTeam = true;
+    Player.X = Random.RandRange(0, Config.BoardWidth - 1);
+    Player.Y = Random.RandRange(0, Config.BoardHeight - 1);
+    Player.Health = Config.PlayerHealth;
+    Player.AttackPower = Config.PlayerAttackPower;
+    OutState.AddPiece(Player);
+
+    // Enemies on free tiles outside the centre 3x3, power-ups on tiles with neither a piece nor
+    // another power-up - drawn without replacement like the game mode
+    FChessSpawnCells SpawnCells;
+    SpawnCells.SetExclusionZone(FIntPoint(Config.BoardWidth / 2, Config.BoardHeight / 2), 1);
+    SpawnCells.Build(OutState.Occupancy, [](int32, int32) { return true; });
+
+    FIntPoint Cell;
+    for (int32 SpawnedCount = 0; SpawnedCount < Config.NumEnemies && Config.EnemyKinds.Num() > 0 && SpawnCells.Draw(Random, Cell); SpawnedCount++)
+    {
+        FChessPieceState Enemy;
+        Enemy.Kind = Config.EnemyKinds[Random.RandRange(0, Config.EnemyKinds.Num() - 1)];
+        Enemy.X = Cell.X;
+        Enemy.Y = Cell.Y;
+        Enemy.Health = Config.EnemyHealth;
+        Enemy.AttackPower = Config.EnemyAttackPower;
+        OutState.AddPiece(Enemy);
+    }
+
+    FChessSpawnCells PowerUpCells;
+    PowerUpCells.Build(OutState.Occupancy, [](int32, int32) { return true; });
+
+    FChessPowerUpState PowerUp;
+    PowerUp.SuperModeMoves = Config.SuperModeMoves;
+
+    for (int32 PlacedCount = 0; PlacedCount < Config.NumPowerUps && PowerUpCells.Draw(Random, Cell); PlacedCount++)
+    {
+        PowerUp.Kind = Random.FRand() < Config.ExtraMoveChance ? EChessPowerUpKind::ExtraMove : EChessPowerUpKind::SuperMode;
+        OutState.SetPowerUp(Cell.X, Cell.Y, PowerUp);
+    }
+
+    // A failed enemy spawn is an immediate win, as in the game
+    FChessRules::UpdateOutcome(OutState);
+}
+
+FChessSimulationResult FChessSimulation::PlayGame(const FChessSimulationConfig& Config, int32 Seed)
+{
+    FChessSimulationResult Result;
+
+    FRandomStream Random(Seed);
+    FChessGameState State;
+    SetupGame(Config, Random, State);
+
+    if (!State.Pieces.IsValidIndex(State.PlayerIndex))
+    {
+        return Result;
+    }
+
+    FChessRules::StartTurn(State);
+
+    while (State.Outcome == EChessOutcome::None && State.Turn <= Config.MaxTurns)
+    {
+        PlayPlayerTurn(Config, Random, State, Result);
+        if (State.Outcome != EChessOutcome::None)
+        {
+            break;
+        }
+
+        PlayEnemyPhase(Config, State, Result);
+        if (State.Outcome != EChessOutcome::None)
+        {
+            break;
+        }
+
+        FChessRules::StartTurn(State);
+    }
+
+    Result.Outcome = State.Outcome;
+    Result.Turns = State.Turn;
+    return Result;
+}
+
+void FChessSimulation::PlayPlayerTurn(const FChessSimulationConfig& Config, FRandomStream& Random, FChessGameState& State, FChessSimulationResult& Result)
+{
+    const FChessPieceState& Player = State.Pieces[State.PlayerIndex];
+
+    FChessTileList Moves;
+    FChessTileList Attacks;
+    FChessRules::GatherValidMoves(State.Occupancy, *State.Tables, Player, Moves);
+    FChessRules::GatherAttackTiles(State.Occupancy, *State.Tables, Player, Attacks);
+
+    if (Config.PlayerPolicy == EChessSimPlayerPolicy::Random)
+    {
+        // Moves, then clashes, then passing
+        const int32 Choice = Random.RandRange(0, Moves.Num() + Attacks.Num());
+        if (Choice < Moves.Num())
+        {
+            ApplyPlayerMove(State, Moves[Choice], Result);
+        }
+        else if (Choice < Moves.Num() + Attacks.Num())
+        {
+            ApplyPlayerClash(State, Attacks[Choice - Moves.Num()], Result);
+        }
+        return;
+    }
+
+    // Eat the strongest enemy in reach - stealing its power is worth the most
+    int32 BestEat = INDEX_NONE;
+    for (int32 i = 0; i < Moves.Num(); i++)
+    {
+        const int32 TargetIndex = State.GetPieceIndexAt(Moves[i].X, Moves[i].Y);
+        if (TargetIndex != INDEX_NONE && (BestEat == INDEX_NONE
+            || State.Pieces[TargetIndex].AttackPower > State.Pieces[State.GetPieceIndexAt(Moves[BestEat].X, Moves[BestEat].Y)].AttackPower))
+        {
+            BestEat = i;
+        }
+    }
+    if (BestEat != INDEX_NONE)
+    {
+        ApplyPlayerMove(State, Moves[BestEat], Result);
+        return;
+    }
+
+    // Clash the weakest adjacent enemy; only right away if the hit finishes it
+    int32 WeakestAttack = INDEX_NONE;
+    for (int32 i = 0; i < Attacks.Num(); i++)
+    {
+        if (WeakestAttack == INDEX_NONE
+            || State.Pieces[State.GetPieceIndexAt(Attacks[i].X, Attacks[i].Y)].Health < State.Pieces[State.GetPieceIndexAt(Attacks[WeakestAttack].X, Attacks[WeakestAttack].Y)].Health)
+        {
+            WeakestAttack = i;
+        }
+    }
+    if (WeakestAttack != INDEX_NONE
+        && State.Pieces[State.GetPieceIndexAt(Attacks[WeakestAttack].X, Attacks[WeakestAttack].Y)].Health <= Player.AttackPower)
+    {
+        ApplyPlayerClash(State, Attacks[WeakestAttack], Result);
+        return;
+    }
+
+    // Squares any enemy could strike next phase
+    TBitArray<> Threatened(false, State.Occupancy.NumSquares());
+    FChessTileList Range;
+    bool bHasPowerUps = false;
+    for (int32 PieceIndex = 0; PieceIndex < State.Pieces.Num(); PieceIndex++)
+    {
+        const FChessPieceState& Enemy = State.Pieces[PieceIndex];
+        if (PieceIndex == State.PlayerIndex || !Enemy.bAlive || Enemy.bPlayerTeam)
+        {
+            continue;
+        }
+
+        FChessRules::GatherAttackRangeTiles(State.Occupancy, *State.Tables, Enemy, Range);
+        for (const FIntPoint& Tile : Range)
+        {
+            Threatened[State.Occupancy.ToIndex(Tile.X, Tile.Y)] = true;
+        }
+    }
+    for (const FChessPowerUpState& PowerUp : State.PowerUps)
+    {
+        bHasPowerUps |= PowerUp.Kind != EChessPowerUpKind::None;
+    }
+
+    // Head for the nearest power-up while any are left, then for the nearest enemy
+    int32 BestMove = INDEX_NONE;
+    int32 BestScore = MIN_int32;
+    for (int32 i = 0; i < Moves.Num(); i++)
+    {
+        const FIntPoint& Move = Moves[i];
+        int32 GoalDistance = MAX_int32;
+
+        for (int32 Square = 0; Square < State.Occupancy.NumSquares(); Square++)
+        {
+            const bool bGoal = bHasPowerUps
+                ? State.PowerUps[Square].Kind != EChessPowerUpKind::None
+                : State.Occupancy.IsOpponentAt(Square, true);
+            if (bGoal)
+            {
+                const FIntPoint Goal = State.Occupancy.ToCoord(Square);
+                GoalDistance = FMath::Min(GoalDistance, ChebyshevDistance(Move.X, Move.Y, Goal.X, Goal.Y));
+            }
+        }
+
+        const int32 Score = (GoalDistance == MAX_int32 ? 0 : -GoalDistance * 10)
+            - (Threatened[State.Occupancy.ToIndex(Move.X, Move.Y)] ? 1000 : 0);
+        if (Score > BestScore)
+        {
+            BestScore = Score;
+            BestMove = i;
+        }
+    }
+
+    const bool bSafeMove = BestMove != INDEX_NONE && !Threatened[State.Occupancy.ToIndex(Moves[BestMove].X, Moves[BestMove].Y)];
+    if (bSafeMove || (BestMove != INDEX_NONE && WeakestAttack == INDEX_NONE))
+    {
+        ApplyPlayerMove(State, Moves[BestMove], Result);
+    }
+    else if (WeakestAttack != INDEX_NONE)
+    {
+        ApplyPlayerClash(State, Attacks[WeakestAttack], Result);
+    }
+}
+
+void FChessSimulation::PlayEnemyPhase(const FChessSimulationConfig& Config, FChessGameState& State, FChessSimulationResult& Result)
+{
+    // ExtraMove skips the phase, exactly like the game mode's enemy phase
+    if (State.bSkipEnemyTurn)
+    {
+        State.bSkipEnemyTurn = false;
+        return;
+    }
+
+    FChessEnemyAction Action;
+    bool bFound = false;
+
+    if (Config.EnemyPolicy == EChessSimEnemyPolicy::Search)
+    {
+        FChessEnemySearch Search(Config.SearchSettings);
+        const FChessSearchResult SearchResult = Search.FindBestAction(State);
+        Action = SearchResult.Action;
+        bFound = SearchResult.bFoundAction;
+    }
+    else
+    {
+        bFound = FChessRules::ChooseGreedyEnemyAction(State, Action);
+    }
+
+    if (bFound && FChessRules::ApplyEnemyAction(State, Action) && Action.bAttack)
+    {
+        Result.EnemyCaptures++;
+    }
+}
@@ -0,0 +1,85 @@
+// ChessSimulation.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessRules.h"
+#include "ChessEnemySearch.h"
+
+// How the scripted player picks its action
+enum class EChessSimPlayerPolicy : uint8
+{
+    Greedy,     // Eat, then finishing clashes, then safe steps toward power-ups and enemies
+    Random      // Uniform over every legal action, passing included
+};
+
+// How the enemy phase picks its action
+enum class EChessSimEnemyPolicy : uint8
+{
+    Greedy,     // FChessRules::ChooseGreedyEnemyAction
+    Search      // FChessEnemySearch with the configured settings
+};
+
+/**
+ * Parameters of one headless game. Defaults mirror ATurnBasedGameMode and the piece
+ * actors: 12x12 board, random player spawn, enemies kept off the centre 3x3,
+ * 50/50 ExtraMove/SuperMode power-ups with 5 super mode moves.
+ */
+struct DUNGEONCHESS_API FChessSimulationConfig
+{
+    int32 BoardWidth = 12;
+    int32 BoardHeight = 12;
+
+    int32 NumEnemies = 1;
+
+    // Each enemy is drawn uniformly from these kinds
+    TArray<EChessPieceKind> EnemyKinds = { EChessPieceKind::Queen };
+
+    int32 NumPowerUps = 3;
+    float ExtraMoveChance = 0.5f;
+    int32 SuperModeMoves = 5;
+
+    int32 PlayerHealth = 150;
+    int32 PlayerAttackPower = 50;
+    int32 EnemyHealth = 100;
+    int32 EnemyAttackPower = 25;
+
+    // Games still running after this many turns count as draws
+    int32 MaxTurns = 200;
+
+    EChessSimPlayerPolicy PlayerPolicy = EChessSimPlayerPolicy::Greedy;
+    EChessSimEnemyPolicy EnemyPolicy = EChessSimEnemyPolicy::Greedy;
+    FChessSearchSettings SearchSettings;
+
+    // Enemy count and kinds the game mode uses for this level (Level_One: 3 knights/bishops, otherwise 1 queen)
+    static FChessSimulationConfig ForLevel(const FString& LevelName);
+};
+
+struct FChessSimulationResult
+{
+    EChessOutcome Outcome = EChessOutcome::None;
+    int32 Turns = 0;
+
+    int32 ExtraMovesCollected = 0;
+    int32 SuperModesCollected = 0;
+
+    int32 EnemiesEaten = 0;
+    int32 EnemiesClashed = 0;
+    int32 EnemyCaptures = 0;
+};
+
+/**
+ * Plays complete DungeonChess games on FChessGameState with scripted policies.
+ * Stateless and thread-safe: every game owns its state and random stream.
+ */
+class DUNGEONCHESS_API FChessSimulation
+{
+public:
+    static FChessSimulationResult PlayGame(const FChessSimulationConfig& Config, int32 Seed);
+
+    // Spawns player, enemies and power-ups the way ATurnBasedGameMode::InitializeGame does
+    static void SetupGame(const FChessSimulationConfig& Config, FRandomStream& Random, FChessGameState& OutState);
+
+private:
+    static void PlayPlayerTurn(const FChessSimulationConfig& Config, FRandomStream& Random, FChessGameState& State, FChessSimulationResult& Result);
+    static void PlayEnemyPhase(const FChessSimulationConfig& Config, FChessGameState& State, FChessSimulationResult& Result);
+};
@@ -0,0 +1,147 @@
+// ChessSimulationCommandlet.cpp
+#include "ChessSimulationCommandlet.h"
+#include "ChessSimulation.h"
+#include "DungeonChess.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    // Win rate of the games with and without at least one pickup of a power-up kind
+    void LogPowerUpImpact(const TCHAR* Name, const TArray<FChessSimulationResult>& Results, int32 FChessSimulationResult::* Collected)
+    {
+        int32 With = 0, WithWins = 0, Without = 0, WithoutWins = 0, Total = 0;
+        for (const FChessSimulationResult& Result : Results)
+        {
+            const bool bWin = Result.Outcome == EChessOutcome::Win;
+            Total += Result.*Collected;
+            if (Result.*Collected > 0)
+            {
+                With++;
+                WithWins += bWin ? 1 : 0;
+            }
+            else
+            {
+                Without++;
+                WithoutWins += bWin ? 1 : 0;
+            }
+        }
+
+        UE_LOG(LogDungeonChess, Display, TEXT("  %-10s picked up in %5.1f%% of games (%.2f per game): win rate %5.1f%% with, %5.1f%% without"),
+            Name,
+            Results.Num() > 0 ? 100.0 * With / Results.Num() : 0.0,
+            Results.Num() > 0 ? static_cast<double>(Total) / Results.Num() : 0.0,
+            With > 0 ? 100.0 * WithWins / With : 0.0,
+            Without > 0 ? 100.0 * WithoutWins / Without : 0.0);
+    }
+}
+
+UChessSimulationCommandlet::UChessSimulationCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UChessSimulationCommandlet::Main(const FString& Params)
+{
+    FString LevelName = TEXT("Level_One");
+    FParse::Value(*Params, TEXT("Level="), LevelName);
+
+    FChessSimulationConfig Config = FChessSimulationConfig::ForLevel(LevelName);
+
+    int32 NumGames = 1000;
+    int32 Seed = 0;
+    float SearchMs = 5.0f;
+
+    FParse::Value(*Params, TEXT("Games="), NumGames);
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Enemies="), Config.NumEnemies);
+    FParse::Value(*Params, TEXT("PowerUps="), Config.NumPowerUps);
+    FParse::Value(*Params, TEXT("Width="), Config.BoardWidth);
+    FParse::Value(*Params, TEXT("Height="), Config.BoardHeight);
+    FParse::Value(*Params, TEXT("MaxTurns="), Config.MaxTurns);
+    FParse::Value(*Params, TEXT("ExtraMoveChance="), Config.ExtraMoveChance);
+    FParse::Value(*Params, TEXT("SuperModeMoves="), Config.SuperModeMoves);
+    FParse::Value(*Params, TEXT("SearchMs="), SearchMs);
+    FParse::Value(*Params, TEXT("SearchDepth="), Config.SearchSettings.MaxDepth);
+
+    FString PlayerPolicy;
+    if (FParse::Value(*Params, TEXT("PlayerPolicy="), PlayerPolicy) && PlayerPolicy.Equals(TEXT("Random"), ESearchCase::IgnoreCase))
+    {
+        Config.PlayerPolicy = EChessSimPlayerPolicy::Random;
+    }
+
+    FString EnemyPolicy;
+    if (FParse::Value(*Params, TEXT("EnemyPolicy="), EnemyPolicy) && EnemyPolicy.Equals(TEXT("Search"), ESearchCase::IgnoreCase))
+    {
+        Config.EnemyPolicy = EChessSimEnemyPolicy::Search;
+    }
+
+    // Many searches run at once here, so keep each one small
+    Config.SearchSettings.TimeBudgetSeconds = FMath::Max(SearchMs, 0.1f) / 1000.0;
+    Config.SearchSettings.TranspositionTableSizeLog2 = 12;
+
+    if (NumGames <= 0 || Config.BoardWidth <= 0 || Config.BoardHeight <= 0)
+    {
+        UE_LOG(LogDungeonChess, Error, TEXT("ChessSimulation: need -Games > 0 and a non-empty board"));
+        return 1;
+    }
+
+    UE_LOG(LogDungeonChess, Display, TEXT("ChessSimulation: %d games on %dx%d, %d enemies, %d power-ups, seed %d, player %s, enemies %s"),
+        NumGames, Config.BoardWidth, Config.BoardHeight, Config.NumEnemies, Config.NumPowerUps, Seed,
+        Config.PlayerPolicy == EChessSimPlayerPolicy::Random ? TEXT("Random") : TEXT("Greedy"),
+        Config.EnemyPolicy == EChessSimEnemyPolicy::Search ? TEXT("Search") : TEXT("Greedy"));
+
+    // Game i always uses seed Seed + i, so a run is reproducible regardless of scheduling
+    TArray<FChessSimulationResult> Results;
+    Results.SetNum(NumGames);
+
+    const double StartTime = FPlatformTime::Seconds();
+    ParallelFor(NumGames, [&Config, &Results, Seed](int32 GameIndex)
+        {
+            Results[GameIndex] = FChessSimulation::PlayGame(Config, Seed + GameIndex);
+        });
+    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+    int32 Wins = 0, Losses = 0, Draws = 0;
+    int64 WinTurns = 0, LossTurns = 0;
+    int64 Eaten = 0, Clashed = 0, Captures = 0;
+    for (const FChessSimulationResult& Result : Results)
+    {
+        switch (Result.Outcome)
+        {
+        case EChessOutcome::Win:
+            Wins++;
+            WinTurns += Result.Turns;
+            break;
+        case EChessOutcome::Lose:
+            Losses++;
+            LossTurns += Result.Turns;
+            break;
+        default:
+            Draws++;
+            break;
+        }
+
+        Eaten += Result.EnemiesEaten;
+        Clashed += Result.EnemiesClashed;
+        Captures += Result.EnemyCaptures;
+    }
+
+    UE_LOG(LogDungeonChess, Display, TEXT("ChessSimulation: %d games in %.2f s (%.0f games/min)"),
+        NumGames, Elapsed, Elapsed > 0.0 ? NumGames * 60.0 / Elapsed : 0.0);
+    UE_LOG(LogDungeonChess, Display, TEXT("  Win %5.1f%%  Lose %5.1f%%  Draw (turn limit %d) %5.1f%%"),
+        100.0 * Wins / NumGames, 100.0 * Losses / NumGames, Config.MaxTurns, 100.0 * Draws / NumGames);
+    UE_LOG(LogDungeonChess, Display, TEXT("  Turns: %.1f average to win, %.1f average to lose"),
+        Wins > 0 ? static_cast<double>(WinTurns) / Wins : 0.0,
+        Losses > 0 ? static_cast<double>(LossTurns) / Losses : 0.0);
+    UE_LOG(LogDungeonChess, Display, TEXT("  Per game: %.2f enemies eaten, %.2f killed by clash, %.2f enemy captures"),
+        static_cast<double>(Eaten) / NumGames, static_cast<double>(Clashed) / NumGames, static_cast<double>(Captures) / NumGames);
+
+    LogPowerUpImpact(TEXT("ExtraMove"), Results, &FChessSimulationResult::ExtraMovesCollected);
+    LogPowerUpImpact(TEXT("SuperMode"), Results, &FChessSimulationResult::SuperModesCollected);
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+// ChessSimulationCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ChessSimulationCommandlet.generated.h"
+
+/**
+ * Headless self-play for balancing. Plays N full games on FChessSimulation across all
+ * cores and logs win rate, game length and how power-ups affect the result.
+ *
+ * UnrealEditor-Cmd DungeonChess.uproject -run=ChessSimulation -Games=10000 -Level=Level_One
+ *
+ * Options: -Games= -Seed= -Level= -Enemies= -PowerUps= -Width= -Height= -MaxTurns=
+ *          -ExtraMoveChance= -SuperModeMoves= -PlayerPolicy=Greedy|Random
+ *          -EnemyPolicy=Greedy|Search -SearchMs= -SearchDepth=
+ */
+UCLASS()
+class DUNGEONCHESS_API UChessSimulationCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UChessSimulationCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,48 @@
+// ChessSpawnCells.cpp
+#include "ChessSpawnCells.h"
+
+void FChessSpawnCells::SetExclusionZone(const FIntPoint& Center, int32 Radius)
+{
+    ExclusionCenter = Center;
+    ExclusionRadius = Radius;
+}
+
+void FChessSpawnCells::Build(const FChessOccupancy& Occupancy, TFunctionRef<bool(int32, int32)> IsEligible)
+{
+    Cells.Reset(Occupancy.NumSquares());
+
+    for (int32 Square = 0; Square < Occupancy.NumSquares(); Square++)
+    {
+        if (Occupancy.IsOccupied(Square))
+        {
+            continue;
+        }
+
+        const FIntPoint Cell = Occupancy.ToCoord(Square);
+        if (ExclusionRadius >= 0
+            && FMath::Abs(Cell.X - ExclusionCenter.X) <= ExclusionRadius
+            && FMath::Abs(Cell.Y - ExclusionCenter.Y) <= ExclusionRadius)
+        {
+            continue;
+        }
+
+        if (IsEligible(Cell.X, Cell.Y))
+        {
+            Cells.Add(Cell);
+        }
+    }
+}
+
+bool FChessSpawnCells::Draw(FRandomStream& Random, FIntPoint& OutCell)
+{
+    if (Cells.Num() == 0)
+    {
+        return false;
+    }
+
+    // Incremental Fisher-Yates: swap the pick out of the remaining range
+    const int32 Pick = Random.RandRange(0, Cells.Num() - 1);
+    OutCell = Cells[Pick];
+    Cells.RemoveAtSwap(Pick, 1, EAllowShrinking::No);
+    return true;
+}
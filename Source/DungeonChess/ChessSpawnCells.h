@@ -0,0 +1,31 @@
+// ChessSpawnCells.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessBitboard.h"
+
+/**
+ * Eligible spawn squares, drawn at random without replacement. Building the list
+ * is one pass over the board and every draw is O(1), so placement always
+ * terminates and never under-spawns while eligible squares remain.
+ */
+class DUNGEONCHESS_API FChessSpawnCells
+{
+public:
+    // Collects empty squares outside the exclusion box that pass IsEligible (X, Y)
+    void Build(const FChessOccupancy& Occupancy, TFunctionRef<bool(int32, int32)> IsEligible);
+
+    // Box of squares (inclusive radius around Center) that is never eligible; set before Build
+    void SetExclusionZone(const FIntPoint& Center, int32 Radius);
+
+    // Picks and removes a random remaining square; false once none are left
+    bool Draw(FRandomStream& Random, FIntPoint& OutCell);
+
+    int32 Num() const { return Cells.Num(); }
+
+private:
+    TArray<FIntPoint> Cells;
+
+    FIntPoint ExclusionCenter = FIntPoint(-1, -1);
+    int32 ExclusionRadius = -1;
+};
@@ -1,6 +1,5 @@
 // ChessTile.cpp
 #include "ChessTile.h"
-#include "ChessPieceBase.h"
 #include "Materials/MaterialInterface.h"
 #include "UObject/ConstructorHelpers.h"
 
@@ -20,7 +19,6 @@ AChessTile::AChessTile()
 
     GridX = 0;
     GridY = 0;
-    OccupyingPiece = nullptr;
     OriginalMaterial = nullptr;
 }
 
@@ -51,4 +49,17 @@ void AChessTile::ResetHighlight()
     {
         TileMesh->SetMaterial(0, OriginalMaterial);
     }
-}
\ No newline at end of file
+}
+
+void AChessTile::Hover()
+{
+    if (TileMesh && HoverMaterial)
+    {
+        if (!OriginalMaterial)
+        {
+            OriginalMaterial = TileMesh->GetMaterial(0);
+        }
+
+        TileMesh->SetMaterial(0, HoverMaterial);
+    }
+}
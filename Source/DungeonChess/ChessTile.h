@@ -29,14 +29,15 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Materials")
     UMaterialInterface* AttackHighlightMaterial;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Materials")
+    UMaterialInterface* HoverMaterial;
+
     int32 GridX;
     int32 GridY;
 
     void Highlight(bool bIsAttackTile = false);
     void ResetHighlight();
-
-    UPROPERTY()
-    class AChessPieceBase* OccupyingPiece;
+    void Hover();
 
 private:
     UPROPERTY()
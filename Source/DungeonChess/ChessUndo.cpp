@@ -0,0 +1,166 @@
+// ChessUndo.cpp
+#include "ChessUndo.h"
+
+namespace
+{
+    bool IsSamePiece(const FChessPieceState& A, const FChessPieceState& B)
+    {
+        return A.Kind == B.Kind && A.Movement == B.Movement && A.bPlayerTeam == B.bPlayerTeam
+            && A.X == B.X && A.Y == B.Y
+            && A.Health == B.Health && A.AttackPower == B.AttackPower && A.MovementRange == B.MovementRange
+            && A.bSuperModeActive == B.bSuperModeActive && A.SuperModeMovesRemaining == B.SuperModeMovesRemaining
+            && A.RevivesRemaining == B.RevivesRemaining
+            && A.bHasActedThisTurn == B.bHasActedThisTurn && A.bAlive == B.bAlive;
+    }
+}
+
+void FChessUndoStack::Push(const FChessGameState& State)
+{
+    if (Depth == Records.Num())
+    {
+        Records.AddDefaulted();
+    }
+
+    FChessUndoRecord& Record = Records[Depth++];
+    Record.Pieces.Reset();
+    Record.PowerUps.Reset();
+    Record.NumPieces = State.Pieces.Num();
+    Record.Turn = State.Turn;
+    Record.bSkipEnemyTurn = State.bSkipEnemyTurn;
+    Record.Outcome = State.Outcome;
+}
+
+void FChessUndoStack::SavePiece(const FChessGameState& State, int32 PieceIndex)
+{
+    check(Depth > 0);
+
+    if (!State.Pieces.IsValidIndex(PieceIndex))
+    {
+        return;
+    }
+
+    FChessUndoRecord& Record = Top();
+    for (const FChessUndoRecord::FPieceEntry& Entry : Record.Pieces)
+    {
+        if (Entry.Index == PieceIndex)
+        {
+            return;
+        }
+    }
+
+    Record.Pieces.Add({ PieceIndex, State.Pieces[PieceIndex] });
+}
+
+void FChessUndoStack::SavePowerUp(const FChessGameState& State, int32 Square)
+{
+    check(Depth > 0);
+
+    if (!State.PowerUps.IsValidIndex(Square))
+    {
+        return;
+    }
+
+    FChessUndoRecord& Record = Top();
+    for (const FChessUndoRecord::FPowerUpEntry& Entry : Record.PowerUps)
+    {
+        if (Entry.Square == Square)
+        {
+            return;
+        }
+    }
+
+    Record.PowerUps.Add({ Square, State.PowerUps[Square] });
+}
+
+void FChessUndoStack::SaveAction(const FChessGameState& State, int32 PieceIndex, int32 X, int32 Y)
+{
+    SavePiece(State, PieceIndex);
+
+    if (State.Occupancy.IsInside(X, Y))
+    {
+        SavePiece(State, State.GetPieceIndexAt(X, Y));
+        SavePowerUp(State, State.Occupancy.ToIndex(X, Y));
+    }
+}
+
+void FChessUndoStack::SaveTurnStart(const FChessGameState& State)
+{
+    for (int32 PieceIndex = 0; PieceIndex < State.Pieces.Num(); PieceIndex++)
+    {
+        if (State.Pieces[PieceIndex].bHasActedThisTurn)
+        {
+            SavePiece(State, PieceIndex);
+        }
+    }
+}
+
+void FChessUndoStack::PushDiff(const FChessGameState& Before, const FChessGameState& After)
+{
+    Push(Before);
+
+    const int32 NumShared = FMath::Min(Before.Pieces.Num(), After.Pieces.Num());
+    for (int32 PieceIndex = 0; PieceIndex < NumShared; PieceIndex++)
+    {
+        if (!IsSamePiece(Before.Pieces[PieceIndex], After.Pieces[PieceIndex]))
+        {
+            SavePiece(Before, PieceIndex);
+        }
+    }
+
+    const int32 NumSquares = FMath::Min(Before.PowerUps.Num(), After.PowerUps.Num());
+    for (int32 Square = 0; Square < NumSquares; Square++)
+    {
+        if (Before.PowerUps[Square].Kind != After.PowerUps[Square].Kind
+            || Before.PowerUps[Square].SuperModeMoves != After.PowerUps[Square].SuperModeMoves)
+        {
+            SavePowerUp(Before, Square);
+        }
+    }
+}
+
+void FChessUndoStack::Pop(FChessGameState& State)
+{
+    check(Depth > 0);
+    const FChessUndoRecord& Record = Records[--Depth];
+
+    // Pieces added after the record
+    for (int32 PieceIndex = State.Pieces.Num() - 1; PieceIndex >= Record.NumPieces; PieceIndex--)
+    {
+        State.LiftPiece(PieceIndex);
+    }
+    State.Pieces.SetNum(Record.NumPieces, EAllowShrinking::No);
+
+    // Lift every changed piece first so restored squares are free
+    for (const FChessUndoRecord::FPieceEntry& Entry : Record.Pieces)
+    {
+        State.LiftPiece(Entry.Index);
+    }
+
+    for (const FChessUndoRecord::FPieceEntry& Entry : Record.Pieces)
+    {
+        State.Pieces[Entry.Index] = Entry.Before;
+        if (Entry.Before.bAlive && State.Occupancy.IsInside(Entry.Before.X, Entry.Before.Y))
+        {
+            State.PlacePiece(Entry.Index, Entry.Before.X, Entry.Before.Y);
+        }
+    }
+
+    for (const FChessUndoRecord::FPowerUpEntry& Entry : Record.PowerUps)
+    {
+        State.PowerUps[Entry.Square] = Entry.Before;
+        State.RefreshSquareHash(Entry.Square);
+    }
+
+    State.Turn = Record.Turn;
+    State.bSkipEnemyTurn = Record.bSkipEnemyTurn;
+    State.Outcome = Record.Outcome;
+}
+
+void FChessUndoStack::DropOldest()
+{
+    if (Depth > 0)
+    {
+        Records.RemoveAt(0);
+        Depth--;
+    }
+}
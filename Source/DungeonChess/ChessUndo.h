@@ -0,0 +1,80 @@
+// ChessUndo.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChessRules.h"
+
+/**
+ * What one step changed, as before-values only: the pieces and power-up squares it
+ * touched plus the game flags. Inline storage covers a single action, so recording
+ * and restoring an action does not touch the heap.
+ */
+struct FChessUndoRecord
+{
+    struct FPieceEntry
+    {
+        int32 Index = INDEX_NONE;
+        FChessPieceState Before;
+    };
+
+    struct FPowerUpEntry
+    {
+        int32 Square = INDEX_NONE;
+        FChessPowerUpState Before;
+    };
+
+    TArray<FPieceEntry, TInlineAllocator<4>> Pieces;
+    TArray<FPowerUpEntry, TInlineAllocator<2>> PowerUps;
+
+    int32 NumPieces = 0;
+    int32 Turn = 0;
+    bool bSkipEnemyTurn = false;
+    EChessOutcome Outcome = EChessOutcome::None;
+};
+
+/**
+ * Make/unmake for FChessGameState. Push a record, save whatever the next rules call
+ * will touch, apply it, and Pop to restore the state exactly (hash included).
+ * Records are pooled, so a search that reuses one stack runs without allocating
+ * once it has reached its deepest ply.
+ *
+ *     Undo.Push(State);
+ *     Undo.SaveAction(State, PieceIndex, X, Y);
+ *     FChessRules::ApplyMove(State, PieceIndex, X, Y);
+ *     ...
+ *     Undo.Pop(State);
+ */
+class DUNGEONCHESS_API FChessUndoStack
+{
+public:
+    // Opens a record holding State's flags and piece count
+    void Push(const FChessGameState& State);
+
+    // Before-values for the open record; saving the same piece or square twice keeps the first
+    void SavePiece(const FChessGameState& State, int32 PieceIndex);
+    void SavePowerUp(const FChessGameState& State, int32 Square);
+
+    // Everything a move, jump attack or eat by PieceIndex onto (X, Y) can change
+    void SaveAction(const FChessGameState& State, int32 PieceIndex, int32 X, int32 Y);
+
+    // Acted flags that FChessRules::StartTurn is about to clear
+    void SaveTurnStart(const FChessGameState& State);
+
+    // Opens a record that turns After back into Before (pieces matched by index)
+    void PushDiff(const FChessGameState& Before, const FChessGameState& After);
+
+    // Restores the state from the most recent record
+    void Pop(FChessGameState& State);
+
+    // Forgets the oldest record, for bounded histories
+    void DropOldest();
+
+    int32 Num() const { return Depth; }
+    void Reset() { Depth = 0; }
+
+private:
+    FChessUndoRecord& Top() { return Records[Depth - 1]; }
+
+    TArray<FChessUndoRecord> Records;
+    int32 Depth = 0;
+};
@@ -0,0 +1,65 @@
+// ChessWorldSubsystem.cpp
+#include "ChessWorldSubsystem.h"
+#include "ChessBoard.h"
+#include "ChessPieceBase.h"
+#include "PlayerChessPiece.h"
+#include "TurnBasedGameMode.h"
+#include "Engine/World.h"
+
+UChessWorldSubsystem* UChessWorldSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UChessWorldSubsystem>() : nullptr;
+}
+
+void UChessWorldSubsystem::Deinitialize()
+{
+    Board = nullptr;
+    GameMode = nullptr;
+    PlayerPiece = nullptr;
+    Pieces.Empty();
+
+    Super::Deinitialize();
+}
+
+void UChessWorldSubsystem::RegisterGame(ATurnBasedGameMode* InGameMode, AChessBoard* InBoard)
+{
+    GameMode = InGameMode;
+    Board = InBoard;
+    PlayerPiece = nullptr;
+    Pieces.Reset();
+}
+
+FChessGameLog* UChessWorldSubsystem::GetGameLog() const
+{
+    return GameMode ? GameMode->GetGameLog() : nullptr;
+}
+
+void UChessWorldSubsystem::AddPiece(AChessPieceBase* Piece)
+{
+    if (Piece)
+    {
+        Pieces.AddUnique(Piece);
+
+        // Pieces respawned by undo arrive with their old index
+        if (Piece->RosterIndex == INDEX_NONE)
+        {
+            Piece->RosterIndex = NextRosterIndex++;
+        }
+    }
+}
+
+void UChessWorldSubsystem::RemovePiece(AChessPieceBase* Piece)
+{
+    Pieces.Remove(Piece);
+
+    if (Piece == PlayerPiece)
+    {
+        PlayerPiece = nullptr;
+    }
+}
+
+APowerUp* UChessWorldSubsystem::GetPowerUpAt(int32 X, int32 Y) const
+{
+    return Board ? Board->GetPowerUpAt(X, Y) : nullptr;
+}
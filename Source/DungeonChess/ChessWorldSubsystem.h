@@ -0,0 +1,64 @@
+// ChessWorldSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ChessWorldSubsystem.generated.h"
+
+class AChessBoard;
+class AChessPieceBase;
+class APlayerChessPiece;
+class APowerUp;
+class ATurnBasedGameMode;
+class FChessGameLog;
+
+/**
+ * Per-world registry of the chess game: the authoritative board, the game mode
+ * running it and the roster of live pieces. Populated by ATurnBasedGameMode::InitializeGame,
+ * so pieces, power-ups and controllers can reach game state without actor scans or casts.
+ */
+UCLASS()
+class DUNGEONCHESS_API UChessWorldSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // Returns null when the world has no chess game
+    static UChessWorldSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual void Deinitialize() override;
+
+    void RegisterGame(ATurnBasedGameMode* InGameMode, AChessBoard* InBoard);
+
+    AChessBoard* GetBoard() const { return Board; }
+    ATurnBasedGameMode* GetGameMode() const { return GameMode; }
+
+    // Event log of the running game; null when there is none
+    FChessGameLog* GetGameLog() const;
+
+    // Piece roster (player and enemies, in spawn order). Assigns each new piece its RosterIndex.
+    void AddPiece(AChessPieceBase* Piece);
+    void RemovePiece(AChessPieceBase* Piece);
+    const TArray<AChessPieceBase*>& GetPieces() const { return Pieces; }
+
+    void SetPlayerPiece(APlayerChessPiece* InPlayerPiece) { PlayerPiece = InPlayerPiece; }
+    APlayerChessPiece* GetPlayerPiece() const { return PlayerPiece; }
+
+    // Power-up registry lives in the board's tile data
+    APowerUp* GetPowerUpAt(int32 X, int32 Y) const;
+
+private:
+    UPROPERTY()
+    AChessBoard* Board = nullptr;
+
+    UPROPERTY()
+    ATurnBasedGameMode* GameMode = nullptr;
+
+    UPROPERTY()
+    APlayerChessPiece* PlayerPiece = nullptr;
+
+    UPROPERTY()
+    TArray<AChessPieceBase*> Pieces;
+
+    int32 NextRosterIndex = 0;
+};
@@ -0,0 +1,121 @@
+// ChessZobrist.cpp
+#include "ChessZobrist.h"
+#include "ChessRules.h"
+#include "ChessMovement.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    // Fixed seed so hashes are stable between runs and builds
+    const uint64 ZobristSeed = 0x44756E6765436873ull;
+
+    uint64 SplitMix64(uint64& State)
+    {
+        uint64 Z = (State += 0x9E3779B97F4A7C15ull);
+        Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+        return Z ^ (Z >> 31);
+    }
+
+    void FillKeys(TArray<uint64>& OutKeys, int32 Num, uint64& State)
+    {
+        OutKeys.SetNumUninitialized(Num);
+        for (uint64& Key : OutKeys)
+        {
+            Key = SplitMix64(State);
+        }
+    }
+}
+
+TSharedRef<const FChessZobrist> FChessZobrist::Get(int32 NumSquares)
+{
+    static FCriticalSection CacheLock;
+    static TMap<int32, TSharedRef<const FChessZobrist>> Cache;
+
+    const int32 Key = FMath::Max(NumSquares, 0);
+
+    FScopeLock Lock(&CacheLock);
+    if (const TSharedRef<const FChessZobrist>* Found = Cache.Find(Key))
+    {
+        return *Found;
+    }
+
+    TSharedRef<FChessZobrist> Zobrist = MakeShared<FChessZobrist>();
+    Zobrist->Build(Key);
+    Cache.Add(Key, Zobrist);
+    return Zobrist;
+}
+
+void FChessZobrist::Build(int32 InNumSquares)
+{
+    NumSquares = InNumSquares;
+
+    // Always drawn in the same order, so a key depends only on its slot
+    uint64 State = ZobristSeed;
+
+    EnemyToMoveKey = SplitMix64(State);
+    SkipEnemyTurnKey = SplitMix64(State);
+
+    for (uint64& Key : SuperModeKeys)
+    {
+        Key = SplitMix64(State);
+    }
+    for (uint64& Key : ReviveKeys)
+    {
+        Key = SplitMix64(State);
+    }
+
+    // Per-square tables last, so boards of different sizes share the keys above
+    FillKeys(PieceKeys, NumSquares * NumPieceKinds * 2, State);
+    FillKeys(HealthKeys, NumSquares * NumStatBuckets, State);
+    FillKeys(AttackKeys, NumSquares * NumStatBuckets, State);
+    FillKeys(PowerUpKeys, NumSquares * NumPowerUpKinds, State);
+
+    // No power-up hashes to zero so empty squares contribute nothing
+    for (int32 Square = 0; Square < NumSquares; Square++)
+    {
+        PowerUpKeys[Square * NumPowerUpKinds + static_cast<int32>(EChessPowerUpKind::None)] = 0;
+    }
+}
+
+uint64 FChessZobrist::HashPiece(const FChessPieceState& Piece, int32 Square) const
+{
+    if (Square < 0 || Square >= NumSquares)
+    {
+        return 0;
+    }
+
+    const int32 Kind = FMath::Clamp(static_cast<int32>(Piece.Kind), 0, NumPieceKinds - 1);
+    const int32 Team = Piece.bPlayerTeam ? 1 : 0;
+    const int32 HealthBucket = FMath::Clamp(Piece.Health / HealthBucketSize, 0, NumStatBuckets - 1);
+    const int32 AttackBucket = FMath::Clamp(Piece.AttackPower / AttackBucketSize, 0, NumStatBuckets - 1);
+
+    uint64 Hash = PieceKeys[(Square * NumPieceKinds + Kind) * 2 + Team];
+    Hash ^= HealthKeys[Square * NumStatBuckets + HealthBucket];
+    Hash ^= AttackKeys[Square * NumStatBuckets + AttackBucket];
+
+    if (Piece.bPlayerTeam)
+    {
+        const int32 SuperModeMoves = Piece.bSuperModeActive ? FMath::Clamp(Piece.SuperModeMovesRemaining, 0, MaxSuperModeMoves) : 0;
+        Hash ^= SuperModeKeys[SuperModeMoves];
+        Hash ^= ReviveKeys[FMath::Clamp(Piece.RevivesRemaining, 0, MaxRevives)];
+    }
+
+    // Custom pieces with different definitions must not share a key
+    if (Piece.Movement)
+    {
+        Hash ^= Piece.Movement->GetHashKey();
+    }
+
+    return Hash;
+}
+
+uint64 FChessZobrist::HashPowerUp(EChessPowerUpKind Kind, int32 Square) const
+{
+    if (Square < 0 || Square >= NumSquares)
+    {
+        return 0;
+    }
+
+    return PowerUpKeys[Square * NumPowerUpKinds + FMath::Clamp(static_cast<int32>(Kind), 0, NumPowerUpKinds - 1)];
+}
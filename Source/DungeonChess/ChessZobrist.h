@@ -0,0 +1,69 @@
+// ChessZobrist.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FChessPieceState;
+enum class EChessPowerUpKind : uint8;
+
+/**
+ * Zobrist keys for 64-bit position hashing. A position hash is the XOR of one
+ * component per square (occupant and power-up) plus the side-to-move keys, so a
+ * change to one square is folded in by XOR-ing its old component out and its new
+ * one in. Keys come from a fixed seed and are identical between runs and between
+ * the board actor and headless FChessGameState, so hashes can be stored and compared.
+ *
+ * Piece components cover kind, team, square, health and attack power buckets,
+ * plus super mode moves and revives for the player team.
+ */
+class DUNGEONCHESS_API FChessZobrist
+{
+public:
+    static constexpr int32 NumPieceKinds = 7;
+    static constexpr int32 NumPowerUpKinds = 4;
+
+    static constexpr int32 HealthBucketSize = 10;
+    static constexpr int32 AttackBucketSize = 5;
+    static constexpr int32 NumStatBuckets = 32;
+
+    static constexpr int32 MaxSuperModeMoves = 15;
+    static constexpr int32 MaxRevives = 7;
+
+    // Returns shared keys for the given number of squares, building them on first use
+    static TSharedRef<const FChessZobrist> Get(int32 NumSquares);
+
+    // Component of a piece standing on Square
+    uint64 HashPiece(const FChessPieceState& Piece, int32 Square) const;
+
+    // Component of a power-up lying on Square (0 for None)
+    uint64 HashPowerUp(EChessPowerUpKind Kind, int32 Square) const;
+
+    // XOR-ed in while the enemies are to act
+    FORCEINLINE uint64 GetEnemyToMoveKey() const { return EnemyToMoveKey; }
+
+    // XOR-ed in while an ExtraMove is pending
+    FORCEINLINE uint64 GetSkipEnemyTurnKey() const { return SkipEnemyTurnKey; }
+
+    FORCEINLINE int32 GetNumSquares() const { return NumSquares; }
+
+private:
+    void Build(int32 InNumSquares);
+
+    int32 NumSquares = 0;
+
+    // [Square][Kind][Team]
+    TArray<uint64> PieceKeys;
+
+    // [Square][Bucket]
+    TArray<uint64> HealthKeys;
+    TArray<uint64> AttackKeys;
+
+    // [Square][Kind]
+    TArray<uint64> PowerUpKeys;
+
+    uint64 SuperModeKeys[MaxSuperModeMoves + 1] = {};
+    uint64 ReviveKeys[MaxRevives + 1] = {};
+
+    uint64 EnemyToMoveKey = 0;
+    uint64 SkipEnemyTurnKey = 0;
+};
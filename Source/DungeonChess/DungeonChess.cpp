@@ -6,4 +6,8 @@
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, DungeonChess, "DungeonChess" );
 
 DEFINE_LOG_CATEGORY(LogDungeonChess)
+DEFINE_LOG_CATEGORY(LogChessPiece)
+DEFINE_LOG_CATEGORY(LogChessPowerUp)
+DEFINE_LOG_CATEGORY(LogChessInput)
+DEFINE_LOG_CATEGORY(LogChessTurn)
  
\ No newline at end of file
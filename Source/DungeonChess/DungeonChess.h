@@ -6,3 +6,17 @@
 
 /** Main log category used across the project */
 DECLARE_LOG_CATEGORY_EXTERN(LogDungeonChess, Log, All);
+
+/**
+ * Compile-time ceiling for the gameplay message categories below. Messages more verbose
+ * than this are compiled out; define it (e.g. to Log) in the target to strip Verbose ones.
+ */
+#ifndef DUNGEONCHESS_MESSAGE_VERBOSITY
+#define DUNGEONCHESS_MESSAGE_VERBOSITY All
+#endif
+
+/** Gameplay message categories, see CHESS_MESSAGE */
+DECLARE_LOG_CATEGORY_EXTERN(LogChessPiece, Log, DUNGEONCHESS_MESSAGE_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogChessPowerUp, Log, DUNGEONCHESS_MESSAGE_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogChessInput, Log, DUNGEONCHESS_MESSAGE_VERBOSITY);
+DECLARE_LOG_CATEGORY_EXTERN(LogChessTurn, Log, DUNGEONCHESS_MESSAGE_VERBOSITY);
@@ -17,14 +17,8 @@ class DUNGEONCHESS_API AKnightChessPiece : public AChessPieceBase
 public:
 	AKnightChessPiece();
 
-	// Override to implement knight-specific movement
-	virtual TArray<FIntPoint> GetValidMoves(class AChessBoard* Board) override;
-
-	// Override to implement knight-specific attack range (same as movement - L-shapes)
-	virtual TArray<FIntPoint> GetAttackTiles(class AChessBoard* Board) override;
-	
-	// Override to show full attack range (all L-shaped positions)
-	virtual TArray<FIntPoint> GetAttackRangeTiles(class AChessBoard* Board) override;
+	// L-shaped jumps (see FChessRules)
+	virtual EChessPieceKind GetPieceKind() const override { return EChessPieceKind::Knight; }
 
 	// Override tick to customize movement animation
 	virtual void Tick(float DeltaTime) override;
@@ -1,7 +1,5 @@
 // PlayerChessPiece.cpp
 #include "PlayerChessPiece.h"
-#include "ChessBoard.h"
-#include "ChessTile.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 
@@ -31,90 +29,18 @@ APlayerChessPiece::APlayerChessPiece()
     Health = 150; // Increased from default 100
 }
 
-TArray<FIntPoint> APlayerChessPiece::GetValidMoves(AChessBoard* Board)
+FChessPieceState APlayerChessPiece::GetRulesState() const
 {
-    TArray<FIntPoint> ValidMoves;
-
-    if (!Board)
-    {
-        return ValidMoves;
-    }
-
-    // Player can move in all 8 directions (like a king in chess)
-    TArray<FIntPoint> Directions = {
-        FIntPoint(1, 0), FIntPoint(-1, 0),   // Right, Left
-        FIntPoint(0, 1), FIntPoint(0, -1),   // Forward, Back
-        FIntPoint(1, 1), FIntPoint(1, -1),  // Diagonal: Right-Forward, Right-Back
-        FIntPoint(-1, 1), FIntPoint(-1, -1)  // Diagonal: Left-Forward, Left-Back
-    };
-
-    for (const FIntPoint& Dir : Directions)
-    {
-        int32 CheckX = GridX + Dir.X;
-        int32 CheckY = GridY + Dir.Y;
-
-            if (Board->IsValidPosition(CheckX, CheckY))
-            {
-                AChessTile* Tile = Board->GetTileAt(CheckX, CheckY);
-                if (Tile)
-                {
-                    // In super mode, can move to tiles with enemies (eat them), but not allies
-                    if (bSuperModeActive && Tile->OccupyingPiece)
-                    {
-                        // Only allow moving to enemy tiles, not allies
-                        if (!IsAlly(Tile->OccupyingPiece))
-                        {
-                            ValidMoves.Add(FIntPoint(CheckX, CheckY));
-                        }
-                    }
-                    // Normal mode - only empty tiles
-                    else if (!Tile->OccupyingPiece)
-                    {
-                        ValidMoves.Add(FIntPoint(CheckX, CheckY));
-                    }
-                }
-            }
-    }
-
-    return ValidMoves;
+    FChessPieceState State = Super::GetRulesState();
+    State.RevivesRemaining = RevivesRemaining;
+    return State;
 }
 
-TArray<FIntPoint> APlayerChessPiece::GetAttackTiles(AChessBoard* Board)
+void APlayerChessPiece::ApplyRulesState(const FChessPieceState& State)
 {
-    TArray<FIntPoint> AttackTiles;
-
-    if (!Board)
-    {
-        return AttackTiles;
-    }
-
-    // Player can always attack in all 8 directions (like a king in chess)
-    TArray<FIntPoint> AllDirections = {
-        FIntPoint(1, 0), FIntPoint(-1, 0),   // Right, Left
-        FIntPoint(0, 1), FIntPoint(0, -1),   // Forward, Back
-        FIntPoint(1, 1), FIntPoint(1, -1),  // Diagonal: Right-Forward, Right-Back
-        FIntPoint(-1, 1), FIntPoint(-1, -1)  // Diagonal: Left-Forward, Left-Back
-    };
-
-    for (const FIntPoint& Dir : AllDirections)
-    {
-        int32 CheckX = GridX + Dir.X;
-        int32 CheckY = GridY + Dir.Y;
-
-        if (Board->IsValidPosition(CheckX, CheckY))
-        {
-            AChessTile* Tile = Board->GetTileAt(CheckX, CheckY);
-            if (Tile && Tile->OccupyingPiece && !IsAlly(Tile->OccupyingPiece))
-            {
-                AttackTiles.Add(FIntPoint(CheckX, CheckY));
-            }
-        }
-    }
-    
-    // In super mode, can also move to tiles with enemies (eat them)
-    // This is handled in GetValidMoves
-
-    return AttackTiles;
+    // Before Super, which re-hashes the square from the full state
+    RevivesRemaining = State.RevivesRemaining;
+    Super::ApplyRulesState(State);
 }
 
 bool APlayerChessPiece::CanAttackDiagonal(int32 TargetX, int32 TargetY)
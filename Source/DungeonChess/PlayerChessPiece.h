@@ -13,9 +13,11 @@ class DUNGEONCHESS_API APlayerChessPiece : public AChessPieceBase
 public:
     APlayerChessPiece();
 
-    // Add these function declarations
-    virtual TArray<FIntPoint> GetValidMoves(class AChessBoard* Board) override;
-    virtual TArray<FIntPoint> GetAttackTiles(class AChessBoard* Board) override;
+    // King steps and attacks, eats enemies in super mode (see FChessRules)
+    virtual EChessPieceKind GetPieceKind() const override { return EChessPieceKind::Player; }
+
+    virtual FChessPieceState GetRulesState() const override;
+    virtual void ApplyRulesState(const FChessPieceState& State) override;
 
     // Player can attack diagonals
     bool CanAttackDiagonal(int32 TargetX, int32 TargetY);
@@ -1,10 +1,26 @@
 // PowerUp.cpp
 #include "PowerUp.h"
 #include "ChessPieceBase.h"
-#include "PlayerChessPiece.h"
 #include "TurnBasedGameMode.h"
+#include "ChessBoard.h"
+#include "ChessWorldSubsystem.h"
+#include "ChessGameLog.h"
 #include "Components/StaticMeshComponent.h"
-#include "Engine/Engine.h"
+#include "ChessDebugMessages.h"
+
+namespace
+{
+    const TCHAR* GetPowerUpName(EPowerUpType Type)
+    {
+        switch (Type)
+        {
+        case EPowerUpType::ExtraMove: return TEXT("Extra Move");
+        case EPowerUpType::SuperMode: return TEXT("Super Mode");
+        case EPowerUpType::Revive:    return TEXT("Revive");
+        default:                      return TEXT("Unknown");
+        }
+    }
+}
 
 APowerUp::APowerUp()
 {
@@ -14,16 +30,9 @@ APowerUp::APowerUp()
     PowerUpMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("PowerUpMesh"));
     RootComponent = PowerUpMesh;
 
-    // Set up collision for overlap - use WorldDynamic so it can be found by queries
-    PowerUpMesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-    PowerUpMesh->SetCollisionObjectType(ECC_WorldDynamic);
-    PowerUpMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
-    PowerUpMesh->SetCollisionResponseToChannel(ECC_Pawn, ECR_Overlap);
-    PowerUpMesh->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Overlap);
-    PowerUpMesh->SetGenerateOverlapEvents(true);
-
-    // Bind overlap event
-    PowerUpMesh->OnComponentBeginOverlap.AddDynamic(this, &APowerUp::OnOverlapBegin);
+    // Picked up through the board's grid registry when a piece arrives on its cell (AChessPieceBase::MoveToPiece);
+    // an overlap would also fire for pieces sliding across the cell
+    PowerUpMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
     // Default values
     PowerUpType = EPowerUpType::ExtraMove;
@@ -71,38 +80,30 @@ void APowerUp::BeginPlay()
         break;
     }
 
-    if (GEngine)
-    {
-        FString PowerUpName;
-        switch (PowerUpType)
-        {
-        case EPowerUpType::ExtraMove:
-            PowerUpName = TEXT("Extra Move");
-            break;
-        case EPowerUpType::SuperMode:
-            PowerUpName = TEXT("Super Mode");
-            break;
-        case EPowerUpType::Revive:
-            PowerUpName = TEXT("Revive");
-            break;
-        default:
-            PowerUpName = TEXT("Unknown");
-            break;
-        }
-
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Cyan,
-            FString::Printf(TEXT("PowerUp spawned: %s"), *PowerUpName));
-    }
+    CHESS_MESSAGE(LogChessPowerUp, Verbose, 3.0f, FColor::Cyan,
+        TEXT("PowerUp spawned: %s"), GetPowerUpName(PowerUpType));
 }
 
-void APowerUp::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-    UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void APowerUp::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    AChessPieceBase* Piece = Cast<AChessPieceBase>(OtherActor);
-    if (Piece)
+    if (AChessBoard* Board = OwningBoard.Get())
     {
-        OnPickup(Piece);
+        Board->UnregisterPowerUp(this);
     }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+static_assert(static_cast<uint8>(EChessPowerUpKind::ExtraMove) == static_cast<uint8>(EPowerUpType::ExtraMove) + 1, "EChessPowerUpKind must mirror EPowerUpType");
+static_assert(static_cast<uint8>(EChessPowerUpKind::SuperMode) == static_cast<uint8>(EPowerUpType::SuperMode) + 1, "EChessPowerUpKind must mirror EPowerUpType");
+static_assert(static_cast<uint8>(EChessPowerUpKind::Revive) == static_cast<uint8>(EPowerUpType::Revive) + 1, "EChessPowerUpKind must mirror EPowerUpType");
+
+FChessPowerUpState APowerUp::GetRulesState() const
+{
+    FChessPowerUpState State;
+    State.Kind = static_cast<EChessPowerUpKind>(static_cast<uint8>(PowerUpType) + 1);
+    State.SuperModeMoves = SuperModeMovesCount;
+    return State;
 }
 
 void APowerUp::OnPickup(AChessPieceBase* Piece)
@@ -112,48 +113,46 @@ void APowerUp::OnPickup(AChessPieceBase* Piece)
         return;
     }
 
+    UChessWorldSubsystem* ChessWorld = UChessWorldSubsystem::Get(this);
+    if (FChessGameLog* GameLog = ChessWorld ? ChessWorld->GetGameLog() : nullptr)
+    {
+        GameLog->LogPickup(Piece->RosterIndex, GridX, GridY, GetRulesState().Kind);
+    }
+
+    // Apply the effect through the rules core
+    FChessPieceState PieceState = Piece->GetRulesState();
+    bool bSkipEnemyTurn = false;
+    FChessRules::ApplyPowerUp(PieceState, GetRulesState(), bSkipEnemyTurn);
+    Piece->ApplyRulesState(PieceState);
+
     switch (PowerUpType)
     {
     case EPowerUpType::ExtraMove:
     {
-        ATurnBasedGameMode* GameMode = Cast<ATurnBasedGameMode>(GetWorld()->GetAuthGameMode());
-        if (GameMode)
+        ATurnBasedGameMode* GameMode = ChessWorld ? ChessWorld->GetGameMode() : nullptr;
+        if (GameMode && bSkipEnemyTurn)
         {
             GameMode->bSkipEnemyTurn = true;
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Cyan,
-                    TEXT("ENEMY TURN SKIPPED! You go again!"));
-            }
+            CHESS_MESSAGE(LogChessPowerUp, Log, 10.0f, FColor::Cyan,
+                TEXT("ENEMY TURN SKIPPED! You go again!"));
         }
         break;
     }
 
     case EPowerUpType::SuperMode:
     {
-        Piece->ActivateSuperMode(SuperModeMovesCount);
-
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Magenta,
-                TEXT("SUPER MODE ACTIVATED!"));
-        }
+        CHESS_MESSAGE(LogChessPowerUp, Log, 10.0f, FColor::Magenta,
+            TEXT("SUPER MODE ACTIVATED! %d moves"), Piece->SuperModeMovesRemaining);
         break;
     }
 
     case EPowerUpType::Revive:
     {
-        if (APlayerChessPiece* Player = Cast<APlayerChessPiece>(Piece))
+        if (Piece->GetPieceKind() == EChessPieceKind::Player)
         {
-            Player->RevivesRemaining++;
-
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Green,
-                    FString::Printf(TEXT("REVIVE OBTAINED! Revives: %d"),
-                        Player->RevivesRemaining));
-            }
+            CHESS_MESSAGE(LogChessPowerUp, Log, 10.0f, FColor::Green,
+                TEXT("REVIVE OBTAINED! Revives: %d"), PieceState.RevivesRemaining);
         }
         break;
     }
@@ -164,4 +163,4 @@ void APowerUp::OnPickup(AChessPieceBase* Piece)
 
     // Destroy the power-up after pickup
     Destroy();
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "ChessRules.h"
 #include "PowerUp.generated.h"
 
 UENUM(BlueprintType)
@@ -51,13 +52,16 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PowerUp|SuperMode")
     int32 SuperModeMovesCount = 5;
 
+    // Grid cell this power-up is registered on; set by AChessBoard::RegisterPowerUp
+    int32 GridX = -1;
+    int32 GridY = -1;
+
+    TWeakObjectPtr<class AChessBoard> OwningBoard;
+
     void OnPickup(class AChessPieceBase* Piece);
+
+    FChessPowerUpState GetRulesState() const;
     
     virtual void BeginPlay() override;
-protected:
-    
-
-    UFUNCTION()
-    void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-        UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 };
\ No newline at end of file
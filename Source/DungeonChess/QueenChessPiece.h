@@ -17,13 +17,6 @@ class DUNGEONCHESS_API AQueenChessPiece : public AChessPieceBase
 public:
 	AQueenChessPiece();
 
-	// Override to implement rook-specific movement
-	virtual TArray<FIntPoint> GetValidMoves(class AChessBoard* Board) override;
-
-	// Override to implement rook-specific attack range (same as movement)
-	virtual TArray<FIntPoint> GetAttackTiles(class AChessBoard* Board) override;
-
-	// Override to show full attack range (entire row and column)
-	virtual TArray<FIntPoint> GetAttackRangeTiles(class AChessBoard* Board) override;
-	
+	// All 8 directions, move 4 / attack 3 (see FChessRules)
+	virtual EChessPieceKind GetPieceKind() const override { return EChessPieceKind::Queen; }
 };
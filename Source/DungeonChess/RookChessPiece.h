@@ -17,12 +17,6 @@ class DUNGEONCHESS_API ARookChessPiece : public AChessPieceBase
 public:
 	ARookChessPiece();
 
-	// Override to implement rook-specific movement
-	virtual TArray<FIntPoint> GetValidMoves(class AChessBoard* Board) override;
-	
-	// Override to implement rook-specific attack range (same as movement)
-	virtual TArray<FIntPoint> GetAttackTiles(class AChessBoard* Board) override;
-	
-	// Override to show full attack range (entire row and column)
-	virtual TArray<FIntPoint> GetAttackRangeTiles(class AChessBoard* Board) override;
+	// Slides along rows and columns (see FChessRules)
+	virtual EChessPieceKind GetPieceKind() const override { return EChessPieceKind::Rook; }
 };
@@ -9,15 +9,47 @@
 #include "KnightChessPiece.h"
 #include "BishopChessPiece.h"
 #include "ChessPlayerController.h"
+#include "ChessWorldSubsystem.h"
+#include "ChessEnemySearch.h"
+#include "ChessSpawnCells.h"
+#include "DungeonChess.h"
+#include "ChessDebugMessages.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/Engine.h"
 #include "TimerManager.h"
 #include "Blueprint/UserWidget.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    // Greedy candidates scored between budget checks; large enough for the parallel scoring to pay off
+    const int32 GreedyScoreBatchSize = 64;
+}
+
+static_assert(static_cast<uint8>(EChessOutcome::Win) == static_cast<uint8>(EGameResult::Win), "EChessOutcome must mirror EGameResult");
+static_assert(static_cast<uint8>(EChessOutcome::Lose) == static_cast<uint8>(EGameResult::Lose), "EChessOutcome must mirror EGameResult");
 
 ATurnBasedGameMode::ATurnBasedGameMode()
 {
     PlayerControllerClass = AChessPlayerController::StaticClass();
     DefaultPawnClass = APlayerChessPiece::StaticClass();
+
+    // Drives the enemy phase
+    PrimaryActorTick.bCanEverTick = true;
+}
+
+void ATurnBasedGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+    Super::InitGame(MapName, Options, ErrorMessage);
+
+    if (UGameplayStatics::HasOption(Options, TEXT("Seed")))
+    {
+        RandomSeed = UGameplayStatics::GetIntOption(Options, TEXT("Seed"), RandomSeed);
+    }
 }
 
 void ATurnBasedGameMode::BeginPlay()
@@ -32,8 +64,71 @@ void ATurnBasedGameMode::BeginPlay()
         }, 0.1f, false);
 }
 
+void ATurnBasedGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+    GameLog.Close();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ATurnBasedGameMode::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    AdvanceEnemyPhase(DeltaSeconds);
+}
+
+void ATurnBasedGameMode::BeginGameLog()
+{
+    FString LogPath;
+    if (bWriteGameLog)
+    {
+        LogPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameLogs"),
+            FString::Printf(TEXT("Game_%d_%s.dclog"), ActiveSeed, *FDateTime::Now().ToString()));
+    }
+
+    if (!GameLog.Begin(LogPath, ActiveSeed, GameBoard->BoardWidth, GameBoard->BoardHeight))
+    {
+        UE_LOG(LogDungeonChess, Warning, TEXT("Could not open game log %s, keeping it in memory"), *LogPath);
+        GameLog.Begin(FString(), ActiveSeed, GameBoard->BoardWidth, GameBoard->BoardHeight);
+    }
+
+    for (AChessPieceBase* Piece : ChessWorld->GetPieces())
+    {
+        if (Piece)
+        {
+            GameLog.LogPieceSpawn(Piece->RosterIndex, Piece->GetRulesState());
+        }
+    }
+
+    for (int32 X = 0; X < GameBoard->BoardWidth; X++)
+    {
+        for (int32 Y = 0; Y < GameBoard->BoardHeight; Y++)
+        {
+            if (APowerUp* PowerUp = GameBoard->GetPowerUpAt(X, Y))
+            {
+                GameLog.LogPowerUpSpawn(X, Y, PowerUp->GetRulesState());
+            }
+        }
+    }
+
+    // Get whatever is pending onto disk if the game crashes
+    if (!SystemErrorHandle.IsValid())
+    {
+        SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddUObject(this, &ATurnBasedGameMode::FlushGameLog);
+    }
+}
+
 void ATurnBasedGameMode::InitializeGame()
 {
+    // Seed first so the whole setup is reproducible from one number
+    ActiveSeed = RandomSeed != 0 ? RandomSeed : static_cast<int32>(FPlatformTime::Cycles() & 0x7FFFFFFF);
+    RandomStream.Initialize(ActiveSeed);
+
+    CHESS_MESSAGE(LogChessTurn, Log, 10.0f, FColor::Cyan,
+        TEXT("Random seed %d (replay with ?Seed=%d)"), ActiveSeed, ActiveSeed);
+
     // Find the game board in the level
     TArray<AActor*> FoundActors;
     UGameplayStatics::GetAllActorsOfClass(GetWorld(), AChessBoard::StaticClass(), FoundActors);
@@ -45,17 +140,22 @@ void ATurnBasedGameMode::InitializeGame()
 
     if (!GameBoard)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 10.0f, FColor::Red, TEXT("ERROR: No ChessBoard found in level!"));
-        }
+        CHESS_MESSAGE(LogChessTurn, Error, 10.0f, FColor::Red, TEXT("ERROR: No ChessBoard found in level!"));
         return;
     }
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TEXT("Chess Board Found!"));
-    }
+    CHESS_MESSAGE(LogChessTurn, Verbose, 5.0f, FColor::Green, TEXT("Chess Board Found!"));
+
+    // Publish the board so pieces and controllers don't have to search for it
+    ChessWorld = UChessWorldSubsystem::Get(this);
+    check(ChessWorld);
+    ChessWorld->RegisterGame(this, GameBoard);
+
+    // Track enemy attack coverage incrementally from board changes
+    const int32 NumSquares = GameBoard->GetOccupancy().NumSquares();
+    EnemyAttackMap.Init(NumSquares);
+    EnemyHighlightedSquares.Init(NumSquares);
+    GameBoard->OnSquareChanged.AddUObject(this, &ATurnBasedGameMode::OnBoardSquareChanged);
 
     // Find the player pawn
     APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
@@ -71,14 +171,11 @@ void ATurnBasedGameMode::InitializeGame()
             if (bRandomPlayerSpawn)
             {
                 // Random spawn anywhere on the board (center of random tile)
-                StartX = FMath::RandRange(0, GameBoard->BoardWidth - 1) + 0.5f;
-                StartY = FMath::RandRange(0, GameBoard->BoardHeight - 1) + 0.5f;
+                StartX = RandomStream.RandRange(0, GameBoard->BoardWidth - 1) + 0.5f;
+                StartY = RandomStream.RandRange(0, GameBoard->BoardHeight - 1) + 0.5f;
 
-                if (GEngine)
-                {
-                    GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan,
-                        FString::Printf(TEXT("Random spawn at (%.1f, %.1f)"), StartX, StartY));
-                }
+                CHESS_MESSAGE(LogChessTurn, Verbose, 5.0f, FColor::Cyan,
+                    TEXT("Random spawn at (%.1f, %.1f)"), StartX, StartY);
             }
             else
             {
@@ -90,11 +187,8 @@ void ATurnBasedGameMode::InitializeGame()
                 StartX = FMath::Clamp(StartX, 0.0f, static_cast<float>(GameBoard->BoardWidth) - 0.01f);
                 StartY = FMath::Clamp(StartY, 0.0f, static_cast<float>(GameBoard->BoardHeight) - 0.01f);
 
-                if (GEngine)
-                {
-                    GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan,
-                        FString::Printf(TEXT("Fixed spawn at (%.1f, %.1f)"), StartX, StartY));
-                }
+                CHESS_MESSAGE(LogChessTurn, Verbose, 5.0f, FColor::Cyan,
+                    TEXT("Fixed spawn at (%.1f, %.1f)"), StartX, StartY);
             }
 
             // Get world location using float precision
@@ -108,20 +202,14 @@ void ATurnBasedGameMode::InitializeGame()
             PlayerPiece->GridY = FMath::FloorToInt(StartY);
 
             // Mark the tile as occupied
-            AChessTile* StartTile = GameBoard->GetTileAt(PlayerPiece->GridX, PlayerPiece->GridY);
-            if (StartTile)
-            {
-                StartTile->OccupyingPiece = PlayerPiece;
-            }
+            GameBoard->SetPieceAt(PlayerPiece->GridX, PlayerPiece->GridY, PlayerPiece);
 
-            AllPieces.Add(PlayerPiece);
+            ChessWorld->SetPlayerPiece(PlayerPiece);
+            ChessWorld->AddPiece(PlayerPiece);
 
-            if (GEngine)
-            {
-                GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green,
-                    FString::Printf(TEXT("Player spawned at tile (%d, %d), precise pos (%.2f, %.2f)"),
-                        PlayerPiece->GridX, PlayerPiece->GridY, StartX, StartY));
-            }
+            CHESS_MESSAGE(LogChessTurn, Verbose, 5.0f, FColor::Green,
+                TEXT("Player spawned at tile (%d, %d), precise pos (%.2f, %.2f)"),
+                PlayerPiece->GridX, PlayerPiece->GridY, StartX, StartY);
         }
     }
 
@@ -139,6 +227,8 @@ void ATurnBasedGameMode::InitializeGame()
     // Show enemy highlights immediately after spawning
     HighlightAllEnemyAttackRanges();
 
+    BeginGameLog();
+
     StartNextTurn();
 }
 
@@ -147,14 +237,11 @@ void ATurnBasedGameMode::StartNextTurn()
     CurrentTurn++;
     bPlayerTurn = true;
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan,
-            FString::Printf(TEXT("===== TURN %d - Your Turn ====="), CurrentTurn));
-    }
+    CHESS_MESSAGE(LogChessTurn, Log, 5.0f, FColor::Cyan,
+        TEXT("===== TURN %d - Your Turn ====="), CurrentTurn);
 
     // Reset all pieces
-    for (AChessPieceBase* Piece : AllPieces)
+    for (AChessPieceBase* Piece : ChessWorld->GetPieces())
     {
         if (Piece)
         {
@@ -163,7 +250,13 @@ void ATurnBasedGameMode::StartNextTurn()
     }
 
     // Show all enemy attack ranges during player's turn
-    HighlightAllEnemyAttackRanges();
+    RefreshEnemyHighlights();
+
+    RecordUndoTurn();
+
+    // Once per turn is often enough for crash repro and keeps file writes off the action path
+    GameLog.LogTurnStart(CurrentTurn, GameBoard ? GameBoard->GetPositionHash() : 0);
+    GameLog.Flush();
 }
 
 void ATurnBasedGameMode::OnPlayerAction()
@@ -173,314 +266,423 @@ void ATurnBasedGameMode::OnPlayerAction()
         return;
     }
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow,
-            TEXT("Player action complete! Enemy turn starting..."));
-    }
+    CHESS_MESSAGE(LogChessTurn, Log, 3.0f, FColor::Yellow,
+        TEXT("Player action complete! Enemy turn starting..."));
 
     bPlayerTurn = false;
 
     // Small delay before enemy turns start
-    FTimerHandle DelayTimer;
-    GetWorld()->GetTimerManager().SetTimer(DelayTimer, [this]()
-        {
-            ExecuteEnemyTurns();
-        }, 0.5f, false);
+    EnemyPhaseStep = EEnemyPhaseStep::StartDelay;
+    EnemyPhaseDelay = EnemyTurnStartDelay;
 }
 
-void ATurnBasedGameMode::ExecuteEnemyTurns()
+void ATurnBasedGameMode::AdvanceEnemyPhase(float DeltaSeconds)
 {
-    // Double-check if enemy turn should be skipped
-    if (bSkipEnemyTurn)
+    if (EnemyPhaseStep == EEnemyPhaseStep::Idle)
     {
-        bSkipEnemyTurn = false;
-
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow,
-                TEXT("Enemy turn forcibly ended!"));
-        }
-
-        StartNextTurn();
         return;
     }
 
-    if (!GameBoard || !PlayerPiece)
+    // Pacing counts down in game time whatever the current step is doing
+    EnemyPhaseDelay = FMath::Max(EnemyPhaseDelay - DeltaSeconds, 0.0f);
+
+    // Steps that finish early leave the rest of the budget to the next one
+    const double Deadline = FPlatformTime::Seconds() + FMath::Max(EnemyPhaseFrameBudgetMs, 0.1f) / 1000.0;
+    while (StepEnemyPhase(Deadline))
     {
-        StartNextTurn();
-        return;
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
     }
-
-    // Keep enemy highlights visible during enemy turn
-    // Don't clear them - they should always be visible
-
-    // Reset enemy index
-    CurrentEnemyIndex = 0;
-
-    // Start processing enemy turns one by one
-    ProcessEnemyTurn();
 }
 
-void ATurnBasedGameMode::ProcessEnemyTurn()
+bool ATurnBasedGameMode::StepEnemyPhase(double Deadline)
 {
-    if (!GameBoard || !PlayerPiece)
+    // The enemy's capture may have ended the game
+    if (GameResult != EGameResult::None)
     {
-        StartNextTurn();
-        return;
+        EnemyPhaseStep = EEnemyPhaseStep::Idle;
+        return false;
     }
 
-    // Collect all valid enemies that haven't acted
-    TArray<AChessPieceBase*> ValidEnemies;
-    for (AChessPieceBase* Enemy : AllPieces)
+    switch (EnemyPhaseStep)
     {
-        if (Enemy && Enemy != PlayerPiece && !Enemy->bHasActedThisTurn)
+    case EEnemyPhaseStep::StartDelay:
+        if (EnemyPhaseDelay > 0.0f)
         {
-            ValidEnemies.Add(Enemy);
+            return false;
         }
-    }
 
-    // If no valid enemies, end enemy turn phase
-    if (ValidEnemies.Num() == 0)
-    {
-        if (GEngine)
+        // Double-check if enemy turn should be skipped
+        if (bSkipEnemyTurn)
         {
-            GEngine->AddOnScreenDebugMessage(-1, 4.0f, FColor::Green,
-                TEXT("Enemy turn complete!"));
+            bSkipEnemyTurn = false;
+
+            CHESS_MESSAGE(LogChessTurn, Log, 3.0f, FColor::Yellow,
+                TEXT("Enemy turn forcibly ended!"));
+
+            EnemyPhaseStep = EEnemyPhaseStep::Idle;
+            StartNextTurn();
+            return false;
         }
 
-        FTimerHandle DelayTimer;
-        GetWorld()->GetTimerManager().SetTimer(DelayTimer, [this]()
-            {
-                StartNextTurn();
-            }, 1.0f, false);
-        return;
-    }
+        if (!GameBoard || !PlayerPiece)
+        {
+            EnemyPhaseStep = EEnemyPhaseStep::Idle;
+            StartNextTurn();
+            return false;
+        }
 
-    // Pick the BEST enemy to act this turn (closest to player or can attack)
-    AChessPieceBase* Enemy = nullptr;
-    float BestScore = -1.0f;
+        EnemyPhaseStep = EEnemyPhaseStep::Snapshot;
+        return true;
 
-    for (AChessPieceBase* Candidate : ValidEnemies)
+    case EEnemyPhaseStep::Snapshot:
     {
-        if (!Candidate || !PlayerPiece)
+        TArray<AChessPieceBase*> SnapshotPieces;
+        CaptureRulesState(EnemyPhaseState, SnapshotPieces);
+
+        EnemyPhasePieces.Reset(SnapshotPieces.Num());
+        for (AChessPieceBase* Piece : SnapshotPieces)
         {
-            continue;
+            EnemyPhasePieces.Add(Piece);
+        }
+
+        EnemyPhaseAction = FChessEnemyAction();
+
+        if (EnemyAIMode == EEnemyAIMode::Search)
+        {
+            StartEnemySearch(EnemyPhaseState);
+            EnemyPhaseStep = EEnemyPhaseStep::WaitForSearch;
+            return true;
         }
 
-        // Check if this enemy can attack the player
-        TArray<FIntPoint> AttackTiles = Candidate->GetAttackTiles(GameBoard);
-        bool bCanAttack = false;
-        for (const FIntPoint& Tile : AttackTiles)
+        GreedyChooser.Begin(EnemyPhaseState);
+        EnemyPhaseStep = EEnemyPhaseStep::ScoreEnemies;
+        return true;
+    }
+
+    case EEnemyPhaseStep::ScoreEnemies:
+        // Each batch is scored in parallel; the budget is checked between batches
+        while (!GreedyChooser.ScoreNext(EnemyPhaseState, GreedyScoreBatchSize))
         {
-            if (Tile.X == PlayerPiece->GridX && Tile.Y == PlayerPiece->GridY)
+            if (FPlatformTime::Seconds() >= Deadline)
             {
-                bCanAttack = true;
-                break;
+                return false;
             }
         }
 
-        // Calculate score: prioritize enemies that can attack (score = 1000), otherwise use inverse distance
-        float Score = 0.0f;
-        if (bCanAttack)
+        EnemyPhaseStep = EEnemyPhaseStep::ChooseMove;
+        return true;
+
+    case EEnemyPhaseStep::ChooseMove:
+        GreedyChooser.Finish(EnemyPhaseState, EnemyPhaseAction);
+        EnemyPhaseStep = EEnemyPhaseStep::Act;
+        return true;
+
+    case EEnemyPhaseStep::WaitForSearch:
+        // OnEnemySearchComplete moves on to Act
+        return false;
+
+    case EEnemyPhaseStep::Act:
+    {
+        AChessPieceBase* Enemy = nullptr;
+        if (EnemyPhasePieces.IsValidIndex(EnemyPhaseAction.PieceIndex))
         {
-            Score = 1000.0f; // High priority for enemies that can attack
+            Enemy = EnemyPhasePieces[EnemyPhaseAction.PieceIndex].Get();
         }
-        else
+        EnemyPhasePieces.Reset();
+
+        ExecuteEnemyAction(Enemy, EnemyPhaseAction);
+
+        // Attack ranges catch up while the action plays out
+        EnemyPhaseStep = EEnemyPhaseStep::RefreshHighlights;
+        EnemyPhaseDelay = EnemyTurnEndDelay;
+        return true;
+    }
+
+    case EEnemyPhaseStep::RefreshHighlights:
+        if (!RefreshEnemyHighlights(Deadline))
         {
-            // Use inverse distance (closer = higher score)
-            float Distance = FVector2D::Distance(
-                FVector2D(Candidate->GridX, Candidate->GridY),
-                FVector2D(PlayerPiece->GridX, PlayerPiece->GridY)
-            );
-            Score = 100.0f / (Distance + 1.0f); // +1 to avoid division by zero
+            return false;
         }
 
-        if (Score > BestScore)
+        EnemyPhaseStep = EEnemyPhaseStep::EndDelay;
+        return true;
+
+    case EEnemyPhaseStep::EndDelay:
+        if (EnemyPhaseDelay > 0.0f)
         {
-            BestScore = Score;
-            Enemy = Candidate;
+            return false;
         }
+
+        EnemyPhaseStep = EEnemyPhaseStep::Idle;
+        StartNextTurn();
+        return false;
+
+    default:
+        return false;
     }
+}
+
+void ATurnBasedGameMode::StartEnemySearch(const FChessGameState& Snapshot)
+{
+    FChessSearchSettings Settings;
+    Settings.MaxDepth = SearchMaxDepth;
+    Settings.TimeBudgetSeconds = FMath::Max(SearchTimeBudgetMs, 1.0f) / 1000.0;
+
+    const int32 SearchId = ++ActiveSearchId;
+    TWeakObjectPtr<ATurnBasedGameMode> WeakThis(this);
+
+    // The search only sees its own copy of the state; the game thread keeps ticking meanwhile
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, SearchId, Settings, State = Snapshot]()
+        {
+            FChessEnemySearch Search(Settings);
+            const FChessSearchResult Result = Search.FindBestAction(State);
 
-    // Fallback to first enemy if none found (shouldn't happen)
-    if (!Enemy && ValidEnemies.Num() > 0)
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, SearchId, Result]()
+                {
+                    if (ATurnBasedGameMode* GameMode = WeakThis.Get())
+                    {
+                        GameMode->OnEnemySearchComplete(SearchId, Result);
+                    }
+                });
+        });
+}
+
+void ATurnBasedGameMode::OnEnemySearchComplete(int32 SearchId, const FChessSearchResult& Result)
+{
+    if (SearchId != ActiveSearchId || EnemyPhaseStep != EEnemyPhaseStep::WaitForSearch || GameResult != EGameResult::None)
     {
-        Enemy = ValidEnemies[0];
+        return;
     }
 
-    if (GEngine)
+    EnemyPhaseAction = Result.Action;
+    if (!Result.bFoundAction)
     {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Orange,
-            FString::Printf(TEXT("Enemy at (%d,%d) is acting..."),
-                Enemy->GridX, Enemy->GridY));
+        EnemyPhaseAction.PieceIndex = INDEX_NONE;
     }
 
-    // Enemy highlights are always visible, no need to re-highlight here
+    CHESS_MESSAGE(LogChessTurn, Log, 3.0f, FColor::Silver,
+        TEXT("Enemy search: depth %d, %lld nodes, %.1f ms"),
+        Result.CompletedDepth, Result.NodesSearched, Result.ElapsedSeconds * 1000.0);
 
-    // Check if player is in attack range (can be anywhere in attack range, not just adjacent)
-    TArray<FIntPoint> AttackTiles = Enemy->GetAttackTiles(GameBoard);
-    bool bCanAttackPlayer = false;
+    EnemyPhaseStep = EEnemyPhaseStep::Act;
+}
 
-    for (const FIntPoint& Tile : AttackTiles)
+void ATurnBasedGameMode::ExecuteEnemyAction(AChessPieceBase* Enemy, const FChessEnemyAction& Action)
+{
+    if (!Enemy || !GameBoard)
     {
-        if (Tile.X == PlayerPiece->GridX && Tile.Y == PlayerPiece->GridY)
-        {
-            bCanAttackPlayer = true;
-            break;
-        }
+        CHESS_MESSAGE(LogChessTurn, Log, 4.0f, FColor::Green,
+            TEXT("Enemy turn complete!"));
+        return;
     }
 
-    if (bCanAttackPlayer)
+    CHESS_MESSAGE(LogChessTurn, Log, 3.0f, FColor::Orange,
+        TEXT("Enemy at (%d,%d) is acting..."),
+        Enemy->GridX, Enemy->GridY);
+
+    GameLog.LogEnemyChoice(Enemy->RosterIndex, Action.Target.X, Action.Target.Y, Action.bAttack, EnemyAIMode == EEnemyAIMode::Search);
+
+    if (Action.bAttack)
     {
         // Jump attack - move to player's position and capture (like chess pieces)
-        Enemy->JumpAttackPiece(PlayerPiece->GridX, PlayerPiece->GridY, GameBoard);
+        Enemy->JumpAttackPiece(Action.Target.X, Action.Target.Y, GameBoard);
 
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red,
-                TEXT("Enemy jumped and captured you!"));
-        }
+        CHESS_MESSAGE(LogChessTurn, Log, 3.0f, FColor::Red,
+            TEXT("Enemy jumped and captured you!"));
     }
-    else
+    else if (GameBoard->IsValidPosition(Action.Target.X, Action.Target.Y))
     {
         // Move towards player
-        TArray<FIntPoint> ValidMoves = Enemy->GetValidMoves(GameBoard);
-
-        if (ValidMoves.Num() > 0)
-        {
-            // Find the move that gets closest to player
-            FIntPoint BestMove = ValidMoves[0];
-            float BestDistance = FLT_MAX;
+        Enemy->MoveToPiece(Action.Target.X, Action.Target.Y, GameBoard);
+    }
 
-            for (const FIntPoint& Move : ValidMoves)
-            {
-                float Distance = FVector2D::Distance(
-                    FVector2D(Move.X, Move.Y),
-                    FVector2D(PlayerPiece->GridX, PlayerPiece->GridY)
-                );
+    // Don't clear highlights - they should always be visible
 
-                if (Distance < BestDistance)
-                {
-                    BestDistance = Distance;
-                    BestMove = Move;
-                }
-            }
+    // ONE enemy has acted - the player's turn follows once the phase finishes
+    CHESS_MESSAGE(LogChessTurn, Log, 3.0f, FColor::Yellow,
+        TEXT("One enemy acted. Your turn!"));
+}
 
-            Enemy->MoveToPiece(BestMove.X, BestMove.Y, GameBoard);
-        }
+void ATurnBasedGameMode::HighlightAllEnemyAttackRanges()
+{
+    if (!GameBoard)
+    {
+        return;
     }
 
-    // Don't clear highlights - they should always be visible
+    // Drop every source and re-add all enemies (full range, not just occupied tiles)
+    EnemyAttackMap.Reset();
+    EnemyAttackSlots.Reset();
+    EnemyAttackSlotOwners.Reset();
+    DirtyAttackSlots.Reset();
 
-    // ONE enemy has acted - immediately end enemy turn and start player turn
-    if (GEngine)
+    for (AChessPieceBase* Enemy : ChessWorld->GetPieces())
     {
-        GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow,
-            TEXT("One enemy acted. Your turn!"));
+        if (Enemy && Enemy != PlayerPiece)
+        {
+            const int32 Slot = EnemyAttackMap.AddSource();
+            EnemyAttackSlots.Add(Enemy, Slot);
+            EnemyAttackSlotOwners.SetNum(FMath::Max(EnemyAttackSlotOwners.Num(), Slot + 1));
+            EnemyAttackSlotOwners[Slot] = Enemy;
+            DirtyAttackSlots.Add(Slot);
+        }
     }
 
-    FTimerHandle DelayTimer;
-    GetWorld()->GetTimerManager().SetTimer(DelayTimer, [this]()
-        {
-            StartNextTurn();
-        }, 1.0f, false);
+    RefreshEnemyHighlights();
 }
 
-void ATurnBasedGameMode::HighlightEnemyAttackRange(AChessPieceBase* Enemy)
+bool ATurnBasedGameMode::RefreshEnemyHighlights(double Deadline)
 {
-    if (!Enemy || !GameBoard)
+    if (!GameBoard)
     {
-        return;
+        return true;
     }
 
-    ClearEnemyHighlights();
+    const FChessOccupancy& Occupancy = GameBoard->GetOccupancy();
 
-    // Highlight valid moves (movement area)
-    TArray<FIntPoint> ValidMoves = Enemy->GetValidMoves(GameBoard);
-    for (const FIntPoint& Move : ValidMoves)
+    // Enemies destroyed without RemoveEnemy (level streaming, editor delete) leave stale slots; free them
+    for (int32 Slot = 0; Slot < EnemyAttackSlotOwners.Num(); Slot++)
     {
-        AChessTile* ChessTile = GameBoard->GetTileAt(Move.X, Move.Y);
-        if (ChessTile)
+        TWeakObjectPtr<AChessPieceBase>& Owner = EnemyAttackSlotOwners[Slot];
+        if (!Owner.IsExplicitlyNull() && !Owner.IsValid())
         {
-            ChessTile->Highlight(false); // Blue/green highlight for movement
-            HighlightedEnemyTiles.Add(ChessTile);
+            EnemyAttackSlots.Remove(Owner);
+            EnemyAttackMap.RemoveSource(Slot);
+            DirtyAttackSlots.Remove(Slot);
+            Owner.Reset();
         }
     }
 
-    // Highlight attack tiles (red highlight)
-    TArray<FIntPoint> AttackTiles = Enemy->GetAttackTiles(GameBoard);
-    for (const FIntPoint& Tile : AttackTiles)
+    // Regenerate the attack range of enemies touched by a board change since the last refresh
+    FChessTileList AttackRangeTiles;
+    TArray<int32, TInlineAllocator<64>> AttackRangeSquares;
+    TArray<int32, TInlineAllocator<64>> ScanSquares;
+
+    for (TSet<int32>::TIterator It = DirtyAttackSlots.CreateIterator(); It; ++It)
     {
-        AChessTile* ChessTile = GameBoard->GetTileAt(Tile.X, Tile.Y);
-        if (ChessTile)
+        const int32 Slot = *It;
+        It.RemoveCurrent();
+
+        AChessPieceBase* Enemy = EnemyAttackSlotOwners[Slot].Get();
+        if (!Enemy)
+        {
+            continue;
+        }
+
+        const FChessPieceState EnemyState = Enemy->GetRulesState();
+        FChessRules::GatherAttackRangeTiles(Occupancy, GameBoard->GetMoveTables(), EnemyState, AttackRangeTiles);
+
+        AttackRangeSquares.Reset();
+        for (const FIntPoint& Tile : AttackRangeTiles)
         {
-            ChessTile->Highlight(true); // Red highlight for attacks
-            HighlightedEnemyTiles.Add(ChessTile);
+            AttackRangeSquares.Add(Occupancy.ToIndex(Tile.X, Tile.Y));
+        }
+
+        // Basic enemies only cover occupied squares; the empty ones they look at must still invalidate them
+        FChessRules::GatherAttackRangeScanTiles(Occupancy, GameBoard->GetMoveTables(), EnemyState, AttackRangeTiles);
+
+        ScanSquares.Reset();
+        for (const FIntPoint& Tile : AttackRangeTiles)
+        {
+            ScanSquares.Add(Occupancy.ToIndex(Tile.X, Tile.Y));
+        }
+
+        EnemyAttackMap.SetCoverage(Slot, AttackRangeSquares, ScanSquares);
+
+        // Half-updated counts stay off the tiles until every dirty enemy is regenerated
+        if (Deadline > 0.0 && DirtyAttackSlots.Num() > 0 && FPlatformTime::Seconds() >= Deadline)
+        {
+            return false;
         }
     }
+
+    // Only touch tiles whose attack count crossed zero
+    EnemyAttackMap.ConsumeChangedSquares([this, &Occupancy](int32 Square)
+        {
+            const bool bAttacked = EnemyAttackMap.IsAttacked(Square);
+            if (bAttacked == EnemyHighlightedSquares.Test(Square))
+            {
+                return;
+            }
+
+            const FIntPoint Coord = Occupancy.ToCoord(Square);
+            if (bAttacked)
+            {
+                GameBoard->HighlightTile(Coord.X, Coord.Y, true); // Red highlight for attacks
+                EnemyHighlightedSquares.Set(Square);
+            }
+            else
+            {
+                GameBoard->ResetTileHighlight(Coord.X, Coord.Y);
+                EnemyHighlightedSquares.Clear(Square);
+            }
+        });
+
+    return true;
 }
 
-void ATurnBasedGameMode::HighlightAllEnemyAttackRanges()
+void ATurnBasedGameMode::RemoveEnemy(AChessPieceBase* Enemy)
 {
-    if (!GameBoard)
+    if (ChessWorld)
     {
-        return;
+        ChessWorld->RemovePiece(Enemy);
     }
 
-    ClearEnemyHighlights();
-
-    // Highlight attack ranges for all enemies (full range, not just occupied tiles)
-    for (AChessPieceBase* Enemy : AllPieces)
+    int32 Slot = INDEX_NONE;
+    if (EnemyAttackSlots.RemoveAndCopyValue(Enemy, Slot))
     {
-        if (Enemy && Enemy != PlayerPiece)
-        {
-            // Get full attack range (all tiles that can be attacked, including empty ones)
-            TArray<FIntPoint> AttackRangeTiles = Enemy->GetAttackRangeTiles(GameBoard);
-            for (const FIntPoint& Tile : AttackRangeTiles)
-            {
-                AChessTile* ChessTile = GameBoard->GetTileAt(Tile.X, Tile.Y);
-                if (ChessTile)
-                {
-                    // Only add if not already highlighted (to avoid duplicates)
-                    if (!HighlightedEnemyTiles.Contains(ChessTile))
-                    {
-                        ChessTile->Highlight(true); // Red highlight for attacks
-                        HighlightedEnemyTiles.Add(ChessTile);
-                    }
-                }
-            }
-        }
+        EnemyAttackMap.RemoveSource(Slot);
+        EnemyAttackSlotOwners[Slot].Reset();
+        DirtyAttackSlots.Remove(Slot);
     }
+
+    // Enemy is being destroyed - refresh highlights
+    RefreshEnemyHighlights();
 }
 
-void ATurnBasedGameMode::RefreshEnemyHighlights()
+bool ATurnBasedGameMode::IsTileUnderEnemyAttack(int32 X, int32 Y) const
 {
-    // Refresh highlights to remove dead enemies' attack ranges
-    HighlightAllEnemyAttackRanges();
+    if (!GameBoard || !GameBoard->IsValidPosition(X, Y) || EnemyHighlightedSquares.Num() == 0)
+    {
+        return false;
+    }
+
+    return EnemyHighlightedSquares.Test(GameBoard->GetOccupancy().ToIndex(X, Y));
 }
 
-void ATurnBasedGameMode::ClearEnemyHighlights()
+void ATurnBasedGameMode::OnBoardSquareChanged(int32 X, int32 Y)
 {
-    for (AChessTile* Tile : HighlightedEnemyTiles)
+    if (!GameBoard || EnemyAttackMap.GetNumSquares() == 0)
+    {
+        return;
+    }
+
+    const int32 Square = GameBoard->GetOccupancy().ToIndex(X, Y);
+
+    // Rays through this square may now be longer or shorter, or a piece may have stepped into reach
+    EnemyAttackMap.ForEachSourceWatching(Square, [this](int32 Slot)
+        {
+            DirtyAttackSlots.Add(Slot);
+        });
+
+    // An enemy arriving here attacks from a new origin
+    if (AChessPieceBase* Occupant = GameBoard->GetPieceAt(X, Y))
     {
-        if (Tile)
+        if (const int32* Slot = EnemyAttackSlots.Find(Occupant))
         {
-            Tile->ResetHighlight();
+            DirtyAttackSlots.Add(*Slot);
         }
     }
-
-    HighlightedEnemyTiles.Empty();
 }
 
 void ATurnBasedGameMode::SpawnRandomEnemies(int32 Count)
 {
     if (!GameBoard)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("No GameBoard for enemy spawn!"));
-        }
+        CHESS_MESSAGE(LogChessTurn, Warning, 5.0f, FColor::Red, TEXT("No GameBoard for enemy spawn!"));
         return;
     }
 
@@ -490,55 +692,43 @@ void ATurnBasedGameMode::SpawnRandomEnemies(int32 Count)
         EPieceType::EnemyQueen,
     };
 
-    int32 SpawnedCount = 0;
-    int32 Attempts = 0;
-    int32 MaxAttempts = Count * 10;
-
-    while (SpawnedCount < Count && Attempts < MaxAttempts)
-    {
-        Attempts++;
-
-        int32 RandomX = FMath::RandRange(0, GameBoard->BoardWidth - 1);
-        int32 RandomY = FMath::RandRange(0, GameBoard->BoardHeight - 1);
+    FString LevelName = GetWorld()->GetMapName();
+    LevelName.RemoveFromStart(GetWorld()->StreamingLevelsPrefix);
 
-        // Skip if too close to player spawn
-        int32 CenterX = GameBoard->BoardWidth / 2;
-        int32 CenterY = GameBoard->BoardHeight / 2;
-        if (FMath::Abs(RandomX - CenterX) <= 1 && FMath::Abs(RandomY - CenterY) <= 1)
-        {
-            continue;
-        }
+    // Free tiles away from the player spawn zone (centre 3x3), drawn without replacement
+    FChessSpawnCells SpawnCells;
+    SpawnCells.SetExclusionZone(FIntPoint(GameBoard->BoardWidth / 2, GameBoard->BoardHeight / 2), 1);
+    SpawnCells.Build(GameBoard->GetOccupancy(), [](int32, int32) { return true; });
 
-        AChessTile* Tile = GameBoard->GetTileAt(RandomX, RandomY);
-        if (!Tile || Tile->OccupyingPiece)
-        {
-            continue;
-        }
+    int32 SpawnedCount = 0;
+    FIntPoint Cell;
 
-        FString LevelName = GetWorld()->GetMapName();
-        LevelName.RemoveFromStart(GetWorld()->StreamingLevelsPrefix);
+    while (SpawnedCount < Count && SpawnCells.Draw(RandomStream, Cell))
+    {
+        const int32 RandomX = Cell.X;
+        const int32 RandomY = Cell.Y;
 
 		int32 Index = 2; // Default to Queen
 
         // Choose random enemy class
         if (LevelName.Contains(TEXT("Level_One")))
         {
-            Index = FMath::RandRange(0, EnemyPieceClasses.Num() - 2);
+            Index = RandomStream.RandRange(0, EnemyPieceClasses.Num() - 2);
         }
 
         // Debug: Check class validity
         if (!EnemyPieceClasses.IsValidIndex(Index) || !EnemyPieceClasses[Index])
         {
-            GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red,
-                FString::Printf(TEXT("Enemy class at index %d is invalid!"), Index));
+            CHESS_MESSAGE(LogChessTurn, Warning, 5.f, FColor::Red,
+                TEXT("Enemy class at index %d is invalid!"), Index);
             continue;
         }
 
         // Debug: Check if class is child of AChessPieceBase
         if (!EnemyPieceClasses[Index]->IsChildOf(AChessPieceBase::StaticClass()))
         {
-            GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red,
-                FString::Printf(TEXT("Class %s is not a child of AChessPieceBase!"), *EnemyPieceClasses[Index]->GetName()));
+            CHESS_MESSAGE(LogChessTurn, Warning, 5.f, FColor::Red,
+                TEXT("Class %s is not a child of AChessPieceBase!"), *EnemyPieceClasses[Index]->GetName());
             continue;
         }
 
@@ -551,9 +741,9 @@ void ATurnBasedGameMode::SpawnRandomEnemies(int32 Count)
         FActorSpawnParameters SpawnParams;
         SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-        GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Orange,
-            FString::Printf(TEXT("Trying to spawn class: %s at grid (%d, %d), world (%.1f, %.1f)"),
-                *EnemyPieceClasses[Index]->GetName(), RandomX, RandomY, SpawnLocation.X, SpawnLocation.Y));
+        CHESS_MESSAGE(LogChessTurn, Verbose, 10.f, FColor::Orange,
+            TEXT("Trying to spawn class: %s at grid (%d, %d), world (%.1f, %.1f)"),
+            *EnemyPieceClasses[Index]->GetName(), RandomX, RandomY, SpawnLocation.X, SpawnLocation.Y);
 
         // Attempt to spawn
         AChessPieceBase* Enemy = GetWorld()->SpawnActor<AChessPieceBase>(
@@ -569,23 +759,26 @@ void ATurnBasedGameMode::SpawnRandomEnemies(int32 Count)
             Enemy->GridY = RandomY;
             Enemy->PieceType = EnemyTypes.IsValidIndex(Index) ? EnemyTypes[Index] : EPieceType::EnemyRook;
 
-            Tile->OccupyingPiece = Enemy;
-            AllPieces.Add(Enemy);
+            GameBoard->SetPieceAt(RandomX, RandomY, Enemy);
+            ChessWorld->AddPiece(Enemy);
             SpawnedCount++;
 
-            GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Green,
-                FString::Printf(TEXT("Successfully spawned %s at grid (%d, %d)"),
-                    *Enemy->GetName(), RandomX, RandomY));
+            CHESS_MESSAGE(LogChessTurn, Verbose, 10.f, FColor::Green,
+                TEXT("Successfully spawned %s at grid (%d, %d)"),
+                *Enemy->GetName(), RandomX, RandomY);
         }
         else
         {
-            GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Red,
-                FString::Printf(TEXT("Failed to spawn %s!"), *EnemyPieceClasses[Index]->GetName()));
+            CHESS_MESSAGE(LogChessTurn, Warning, 10.f, FColor::Red,
+                TEXT("Failed to spawn %s!"), *EnemyPieceClasses[Index]->GetName());
         }
     }
 
-    GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow,
-        FString::Printf(TEXT("Spawned %d enemies after %d attempts"), SpawnedCount, Attempts));
+    if (SpawnedCount < Count)
+    {
+        CHESS_MESSAGE(LogChessTurn, Warning, 5.0f, FColor::Red,
+            TEXT("Only %d of %d enemies fit on the board"), SpawnedCount, Count);
+    }
 }
 
 
@@ -596,67 +789,313 @@ void ATurnBasedGameMode::SpawnRandomPowerUps(int32 Count)
         return;
     }
 
-    TSubclassOf<APowerUp> ClassToSpawn;
-    if (PowerUpClass)
+    // Tiles with neither a piece nor another power-up, drawn without replacement
+    FChessSpawnCells SpawnCells;
+    SpawnCells.Build(GameBoard->GetOccupancy(), [this](int32 X, int32 Y) { return !GameBoard->GetPowerUpAt(X, Y); });
+
+    int32 SpawnedCount = 0;
+    FIntPoint Cell;
+
+    while (SpawnedCount < Count && SpawnCells.Draw(RandomStream, Cell))
     {
-        ClassToSpawn = PowerUpClass;
+        const int32 RandomX = Cell.X;
+        const int32 RandomY = Cell.Y;
+
+        // Randomly assign power-up type (50/50 chance)
+        const EPowerUpType Type = RandomStream.GetFraction() < 0.5f ? EPowerUpType::ExtraMove : EPowerUpType::SuperMode;
+
+        if (APowerUp* PowerUp = SpawnPowerUpAt(RandomX, RandomY, Type, 5))
+        {
+            SpawnedCount++;
+
+            CHESS_MESSAGE(LogChessTurn, Verbose, 3.0f, FColor::Yellow,
+                TEXT("Spawned %s at (%d,%d)"),
+                PowerUp->PowerUpType == EPowerUpType::ExtraMove ? TEXT("Extra Move") : TEXT("Super Mode"),
+                RandomX, RandomY);
+        }
     }
-    else
+
+    if (SpawnedCount < Count)
+    {
+        CHESS_MESSAGE(LogChessTurn, Warning, 5.0f, FColor::Red,
+            TEXT("Only %d of %d power-ups fit on the board"), SpawnedCount, Count);
+    }
+}
+
+APowerUp* ATurnBasedGameMode::SpawnPowerUpAt(int32 X, int32 Y, EPowerUpType Type, int32 SuperModeMovesCount)
+{
+    TSubclassOf<APowerUp> ClassToSpawn = PowerUpClass ? PowerUpClass : TSubclassOf<APowerUp>(APowerUp::StaticClass());
+
+    // Use the same positioning method as player pieces for consistency
+    float CenterX = X + 0.5f;
+    float CenterY = Y + 0.5f;
+    FVector SpawnLocation = GameBoard->GetWorldLocationForTileFloat(CenterX, CenterY);
+    SpawnLocation.Z = 50.0f; // Lower than pieces
+    FRotator SpawnRotation = FRotator::ZeroRotator;
+    FActorSpawnParameters SpawnParams;
+
+    APowerUp* PowerUp = GetWorld()->SpawnActor<APowerUp>(ClassToSpawn, SpawnLocation, SpawnRotation, SpawnParams);
+    if (!PowerUp)
     {
-        ClassToSpawn = APowerUp::StaticClass();
+        return nullptr;
     }
 
-    for (int32 i = 0; i < Count; i++)
+    PowerUp->PowerUpType = Type;
+    PowerUp->SuperModeMovesCount = SuperModeMovesCount;
+
+    GameBoard->RegisterPowerUp(PowerUp, X, Y);
+
+    // Force BeginPlay to update mesh
+    PowerUp->BeginPlay();
+
+    return PowerUp;
+}
+
+void ATurnBasedGameMode::CaptureRulesState(FChessGameState& OutState, TArray<AChessPieceBase*>& OutPieces) const
+{
+    OutPieces.Reset();
+
+    if (!GameBoard || !ChessWorld)
     {
-        int32 RandomX = FMath::RandRange(0, GameBoard->BoardWidth - 1);
-        int32 RandomY = FMath::RandRange(0, GameBoard->BoardHeight - 1);
+        OutState = FChessGameState();
+        return;
+    }
 
-        AChessTile* Tile = GameBoard->GetTileAt(RandomX, RandomY);
+    OutState.Init(GameBoard->BoardWidth, GameBoard->BoardHeight);
 
-        if (Tile && !Tile->OccupyingPiece)
+    for (AChessPieceBase* Piece : ChessWorld->GetPieces())
+    {
+        if (Piece)
         {
-            // Use the same positioning method as player pieces for consistency
-            float CenterX = RandomX + 0.5f;
-            float CenterY = RandomY + 0.5f;
-            FVector SpawnLocation = GameBoard->GetWorldLocationForTileFloat(CenterX, CenterY);
-            SpawnLocation.Z = 50.0f; // Lower than pieces
-            FRotator SpawnRotation = FRotator::ZeroRotator;
-            FActorSpawnParameters SpawnParams;
+            OutState.AddPiece(Piece->GetRulesState());
+            OutPieces.Add(Piece);
+        }
+    }
+
+    for (int32 X = 0; X < GameBoard->BoardWidth; X++)
+    {
+        for (int32 Y = 0; Y < GameBoard->BoardHeight; Y++)
+        {
+            if (APowerUp* PowerUp = GameBoard->GetPowerUpAt(X, Y))
+            {
+                OutState.SetPowerUp(X, Y, PowerUp->GetRulesState());
+            }
+        }
+    }
 
-            APowerUp* PowerUp = GetWorld()->SpawnActor<APowerUp>(ClassToSpawn, SpawnLocation, SpawnRotation, SpawnParams);
+    OutState.Turn = CurrentTurn;
+    OutState.bSkipEnemyTurn = bSkipEnemyTurn;
+    OutState.Outcome = static_cast<EChessOutcome>(GameResult);
+}
 
-            if (PowerUp)
+uint64 ATurnBasedGameMode::GetPositionHash() const
+{
+    if (!GameBoard)
+    {
+        return 0;
+    }
+
+    const TSharedRef<const FChessZobrist> Zobrist = FChessZobrist::Get(GameBoard->GetOccupancy().NumSquares());
+
+    uint64 Hash = GameBoard->GetPositionHash();
+    if (!bPlayerTurn)
+    {
+        Hash ^= Zobrist->GetEnemyToMoveKey();
+    }
+    if (bSkipEnemyTurn)
+    {
+        Hash ^= Zobrist->GetSkipEnemyTurnKey();
+    }
+    return Hash;
+}
+
+void ATurnBasedGameMode::CaptureUndoState(FChessGameState& OutState)
+{
+    OutState.Init(GameBoard->BoardWidth, GameBoard->BoardHeight);
+
+    // Pieces keep their roster slot for the whole game, dead or alive
+    for (AChessPieceBase* Piece : ChessWorld->GetPieces())
+    {
+        if (!Piece || Piece->RosterIndex == INDEX_NONE)
+        {
+            continue;
+        }
+
+        if (Piece->RosterIndex >= UndoPieces.Num())
+        {
+            UndoPieces.SetNum(Piece->RosterIndex + 1);
+        }
+
+        FChessUndoPiece& Entry = UndoPieces[Piece->RosterIndex];
+        if (Entry.Actor.Get() != Piece)
+        {
+            Entry.Actor = Piece;
+            Entry.Class = Piece->GetClass();
+            Entry.PieceType = Piece->PieceType;
+        }
+    }
+
+    for (FChessUndoPiece& Entry : UndoPieces)
+    {
+        AChessPieceBase* Actor = Entry.Actor.Get();
+        if (Actor && !Actor->IsActorBeingDestroyed())
+        {
+            Entry.LastState = Actor->GetRulesState();
+        }
+        else
+        {
+            Entry.LastState.bAlive = false;
+        }
+        OutState.AddPiece(Entry.LastState);
+    }
+
+    for (int32 X = 0; X < GameBoard->BoardWidth; X++)
+    {
+        for (int32 Y = 0; Y < GameBoard->BoardHeight; Y++)
+        {
+            if (APowerUp* PowerUp = GameBoard->GetPowerUpAt(X, Y))
             {
-                // Randomly assign power-up type (50/50 chance)
-                PowerUp->PowerUpType = FMath::RandBool() ? EPowerUpType::ExtraMove : EPowerUpType::SuperMode;
+                OutState.SetPowerUp(X, Y, PowerUp->GetRulesState());
+            }
+        }
+    }
+
+    OutState.Turn = CurrentTurn;
+    OutState.bSkipEnemyTurn = bSkipEnemyTurn;
+    OutState.Outcome = static_cast<EChessOutcome>(GameResult);
+}
 
-                // Set super mode moves count
-                PowerUp->SuperModeMovesCount = 5;
+void ATurnBasedGameMode::RecordUndoTurn()
+{
+    if (!GameBoard || !ChessWorld || MaxUndoTurns <= 0)
+    {
+        return;
+    }
 
-                // Force BeginPlay to update mesh
-                PowerUp->BeginPlay();
+    FChessGameState Current;
+    CaptureUndoState(Current);
 
-                if (GEngine)
-                {
-                    GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow,
-                        FString::Printf(TEXT("Spawned %s at (%d,%d)"),
-                            PowerUp->PowerUpType == EPowerUpType::ExtraMove ? TEXT("Extra Move") : TEXT("Super Mode"),
-                            RandomX, RandomY));
-                }
+    // Only what changed since the last turn start is stored
+    if (bHasUndoTurnState)
+    {
+        UndoHistory.PushDiff(UndoTurnState, Current);
+        while (UndoHistory.Num() > MaxUndoTurns)
+        {
+            UndoHistory.DropOldest();
+        }
+    }
+
+    UndoTurnState = MoveTemp(Current);
+    bHasUndoTurnState = true;
+}
+
+bool ATurnBasedGameMode::UndoLastTurn()
+{
+    if (!bPlayerTurn || GameResult != EGameResult::None || !GameBoard || !ChessWorld || UndoHistory.Num() == 0)
+    {
+        CHESS_MESSAGE(LogChessTurn, Log, 2.0f, FColor::Orange, TEXT("Nothing to undo"));
+        return false;
+    }
+
+    UndoHistory.Pop(UndoTurnState);
+    RestoreUndoState(UndoTurnState);
+
+    CurrentTurn = UndoTurnState.Turn;
+    bSkipEnemyTurn = UndoTurnState.bSkipEnemyTurn;
+
+    GameLog.LogUndo(CurrentTurn);
+
+    CHESS_MESSAGE(LogChessTurn, Log, 3.0f, FColor::Cyan,
+        TEXT("===== UNDO - back to turn %d ====="), CurrentTurn);
+    return true;
+}
+
+void ATurnBasedGameMode::RestoreUndoState(const FChessGameState& State)
+{
+    // Power-ups are cheap to recreate, so swap the whole set
+    for (int32 X = 0; X < GameBoard->BoardWidth; X++)
+    {
+        for (int32 Y = 0; Y < GameBoard->BoardHeight; Y++)
+        {
+            if (APowerUp* PowerUp = GameBoard->GetPowerUpAt(X, Y))
+            {
+                GameBoard->UnregisterPowerUp(PowerUp);
+                PowerUp->Destroy();
             }
         }
-        else
+    }
+
+    for (int32 Square = 0; Square < State.PowerUps.Num(); Square++)
+    {
+        const FChessPowerUpState& PowerUp = State.PowerUps[Square];
+        if (PowerUp.Kind != EChessPowerUpKind::None)
         {
-            i--;
+            const FIntPoint Coord = State.Occupancy.ToCoord(Square);
+            SpawnPowerUpAt(Coord.X, Coord.Y, static_cast<EPowerUpType>(static_cast<uint8>(PowerUp.Kind) - 1), PowerUp.SuperModeMoves);
         }
     }
+
+    // Take every piece off the board first so restored squares are free
+    for (const FChessUndoPiece& Entry : UndoPieces)
+    {
+        AChessPieceBase* Actor = Entry.Actor.Get();
+        if (Actor && GameBoard->GetPieceAt(Actor->GridX, Actor->GridY) == Actor)
+        {
+            GameBoard->SetPieceAt(Actor->GridX, Actor->GridY, nullptr);
+        }
+    }
+
+    for (int32 PieceIndex = 0; PieceIndex < UndoPieces.Num() && PieceIndex < State.Pieces.Num(); PieceIndex++)
+    {
+        FChessUndoPiece& Entry = UndoPieces[PieceIndex];
+        const FChessPieceState& Piece = State.Pieces[PieceIndex];
+        if (!Piece.bAlive)
+        {
+            continue;
+        }
+
+        // Pieces captured since then come back as fresh actors of the same class
+        AChessPieceBase* Actor = Entry.Actor.Get();
+        if (!Actor || Actor->IsActorBeingDestroyed())
+        {
+            FVector SpawnLocation = GameBoard->GetWorldLocationForTileFloat(Piece.X + 0.5f, Piece.Y + 0.5f);
+            SpawnLocation.Z = 0.0f;
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+            Actor = Entry.Class ? GetWorld()->SpawnActor<AChessPieceBase>(Entry.Class, SpawnLocation, FRotator(0.f, 90.f, 0.f), SpawnParams) : nullptr;
+            if (!Actor)
+            {
+                continue;
+            }
+
+            Actor->PieceType = Entry.PieceType;
+            Actor->RosterIndex = PieceIndex;
+            ChessWorld->AddPiece(Actor);
+            Entry.Actor = Actor;
+        }
+
+        Actor->ApplyRulesState(Piece);
+        Actor->bHasActedThisTurn = false;
+        Actor->SnapToTile(GameBoard, Piece.X, Piece.Y);
+        GameBoard->SetPieceAt(Piece.X, Piece.Y, Actor);
+        Entry.LastState = Piece;
+    }
+
+    // Respawned enemies need attack map slots
+    HighlightAllEnemyAttackRanges();
 }
 
 void ATurnBasedGameMode::CheckWinCondition()
 {
+    if (!ChessWorld)
+    {
+        return;
+    }
+
     // Count living enemies (exclude player)
     int32 EnemyCount = 0;
-    for (AChessPieceBase* Piece : AllPieces)
+    for (AChessPieceBase* Piece : ChessWorld->GetPieces())
     {
         if (Piece && Piece != PlayerPiece && Piece->Health > 0)
         {
@@ -666,11 +1105,8 @@ void ATurnBasedGameMode::CheckWinCondition()
 
     if (EnemyCount == 0)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green,
-                TEXT("All enemies defeated! Victory!"));
-        }
+        CHESS_MESSAGE(LogChessTurn, Log, 5.0f, FColor::Green,
+            TEXT("All enemies defeated! Victory!"));
         EndGame(EGameResult::Win);
     }
 }
@@ -679,11 +1115,8 @@ void ATurnBasedGameMode::CheckLoseCondition()
 {
     if (!PlayerPiece || PlayerPiece->Health <= 0)
     {
-        if (GEngine)
-        {
-            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red,
-                TEXT("Player defeated! Game Over!"));
-        }
+        CHESS_MESSAGE(LogChessTurn, Log, 5.0f, FColor::Red,
+            TEXT("Player defeated! Game Over!"));
         EndGame(EGameResult::Lose);
     }
 }
@@ -696,6 +1129,12 @@ void ATurnBasedGameMode::EndGame(EGameResult Result)
     }
     GameResult = Result;
 
+    // Nothing of an unfinished enemy phase runs after the game is decided
+    EnemyPhaseStep = EEnemyPhaseStep::Idle;
+
+    GameLog.LogGameEnd(static_cast<EChessOutcome>(Result));
+    GameLog.Close();
+
     APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
     if (!PC) return;
 
@@ -721,19 +1160,14 @@ void ATurnBasedGameMode::EndGame(EGameResult Result)
             // Add to viewport after setting property
             EndGameWidget->AddToViewport(100);
 
-            GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, TEXT("End Game Widget Added!"));
+            CHESS_MESSAGE(LogChessTurn, Verbose, 5.f, FColor::Yellow, TEXT("End Game Widget Added!"));
         }
     }
 
 
 
-    if (GEngine)
-    {
-        GEngine->AddOnScreenDebugMessage(
-            -1, 10.f,
-            Result == EGameResult::Win ? FColor::Green : FColor::Red,
-            Result == EGameResult::Win ? TEXT("YOU WIN!") : TEXT("YOU LOSE!")
-        );
-    }
+    CHESS_MESSAGE(LogChessTurn, Log, 10.f,
+        Result == EGameResult::Win ? FColor::Green : FColor::Red,
+        TEXT("%s"), Result == EGameResult::Win ? TEXT("YOU WIN!") : TEXT("YOU LOSE!"));
 }
 
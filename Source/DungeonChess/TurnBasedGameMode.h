@@ -3,6 +3,10 @@
 
 #include "CoreMinimal.h"
 #include "ChessPieceBase.h"
+#include "ChessAttackMap.h"
+#include "ChessRules.h"
+#include "ChessUndo.h"
+#include "ChessGameLog.h"
 #include "GameFramework/GameModeBase.h"
 #include "TurnBasedGameMode.generated.h"
 
@@ -14,6 +18,39 @@ enum class EGameResult : uint8
     Lose
 };
 
+UENUM(BlueprintType)
+enum class EEnemyAIMode : uint8
+{
+    Greedy,     // Best-scoring enemy acts, no lookahead
+    Search      // Alpha-beta lookahead on a worker thread
+};
+
+// Steps of the enemy phase, advanced from Tick; see ATurnBasedGameMode::AdvanceEnemyPhase
+enum class EEnemyPhaseStep : uint8
+{
+    Idle,               // Player's turn, or the game is over
+    StartDelay,         // Pacing after the player acted
+    Snapshot,           // Capture the rules state and launch the search or start scoring
+    ScoreEnemies,       // Greedy: score candidates a batch at a time
+    ChooseMove,         // Greedy: pick the best enemy's capture or move
+    WaitForSearch,      // Search: the worker has not reported back yet
+    Act,                // Play the chosen action on the actors
+    RefreshHighlights,  // Regenerate dirty attack ranges a few enemies at a time
+    EndDelay            // Pacing before the player's next turn
+};
+
+struct FChessSearchResult;
+enum class EPowerUpType : uint8;
+
+// A piece as the undo history knows it: index-stable for the whole game, with enough to respawn it
+struct FChessUndoPiece
+{
+    TWeakObjectPtr<AChessPieceBase> Actor;
+    TSubclassOf<AChessPieceBase> Class;
+    EPieceType PieceType = EPieceType::EnemyRook;
+    FChessPieceState LastState;
+};
+
 UCLASS()
 class DUNGEONCHESS_API ATurnBasedGameMode : public AGameModeBase
 {
@@ -31,6 +68,11 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Classes")
     TSubclassOf<class APowerUp> PowerUpClass;
 
+    // Seed for every random decision of a game (spawns, enemy kinds, power-up types).
+    // 0 picks a fresh seed per game; the URL option ?Seed=N overrides this.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Random")
+    int32 RandomSeed = 0;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player Spawn")
     bool bRandomPlayerSpawn = true;
 
@@ -40,11 +82,34 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player Spawn", meta = (EditCondition = "!bRandomPlayerSpawn"))
     float PlayerStartY = 4.5f;
 
-    UPROPERTY()
-    class AChessBoard* GameBoard;
+    // How the acting enemy and its action are chosen each enemy phase
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI")
+    EEnemyAIMode EnemyAIMode = EEnemyAIMode::Search;
+
+    // Wall-clock time the lookahead may think per enemy phase; deeper search on faster machines
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI", meta = (ClampMin = "1.0", EditCondition = "EnemyAIMode == EEnemyAIMode::Search"))
+    float SearchTimeBudgetMs = 50.0f;
+
+    // Lookahead cap in plies (one enemy action or one player reply each)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI", meta = (ClampMin = "1", ClampMax = "16", EditCondition = "EnemyAIMode == EEnemyAIMode::Search"))
+    int32 SearchMaxDepth = 6;
+
+    // Game-thread time per frame the enemy phase may spend on its own work (greedy scoring, the
+    // move choice, attack range regeneration); the rest continues next frame. At least one unit
+    // of work runs per frame, so very small budgets only slow the phase down.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI", meta = (ClampMin = "0.1"))
+    float EnemyPhaseFrameBudgetMs = 2.0f;
+
+    // Pacing between the player's action and the enemy's; computation does not count against it
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI", meta = (ClampMin = "0.0"))
+    float EnemyTurnStartDelay = 0.5f;
+
+    // Pacing between the enemy's action and the player's next turn, while its animation plays
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy AI", meta = (ClampMin = "0.0"))
+    float EnemyTurnEndDelay = 1.0f;
 
     UPROPERTY()
-    TArray<class AChessPieceBase*> AllPieces;
+    class AChessBoard* GameBoard;
 
     UPROPERTY()
     class APlayerChessPiece* PlayerPiece;
@@ -59,17 +124,54 @@ public:
     void OnPlayerAction();
 
     void StartNextTurn();
-    void ExecuteEnemyTurns();
+
+    // True from the player's action until the player's next turn starts
+    bool IsEnemyPhaseActive() const { return EnemyPhaseStep != EEnemyPhaseStep::Idle; }
 
     void SpawnRandomEnemies(int32 Count);
     void SpawnRandomPowerUps(int32 Count);
     
     // Refresh enemy highlights (e.g., when enemies die)
-    void RefreshEnemyHighlights();
+    // Only enemies whose attack range touches a square changed since the last refresh are regenerated
+    void RefreshEnemyHighlights() { RefreshEnemyHighlights(0.0); }
+
+    // Same, but stops regenerating once FPlatformTime::Seconds() passes Deadline (0 for none) and
+    // returns false; the remaining enemies stay dirty and tiles are only updated once all are done
+    bool RefreshEnemyHighlights(double Deadline);
+
+    // Remove a dead enemy from the piece roster and from the attack map
+    void RemoveEnemy(class AChessPieceBase* Enemy);
+
+    // True if the tile is currently shown as attacked by an enemy
+    bool IsTileUnderEnemyAttack(int32 X, int32 Y) const;
+
+    // Seed the current game was started with; starting a game with it reproduces the spawns
+    int32 GetActiveSeed() const { return ActiveSeed; }
+
+    // Zobrist hash of the live position: board pieces and power-ups, side to move and a pending ExtraMove
+    uint64 GetPositionHash() const;
+
+    // Snapshot of the live game for FChessRules; OutPieces[i] is the actor behind OutState.Pieces[i]
+    void CaptureRulesState(FChessGameState& OutState, TArray<AChessPieceBase*>& OutPieces) const;
 
     UPROPERTY(BlueprintReadWrite, Category = "Turn Management")
     bool bSkipEnemyTurn = false;
 
+    // Player turns that can be taken back
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Turn Management", meta = (ClampMin = "0"))
+    int32 MaxUndoTurns = 16;
+
+    // Rewinds to the start of the previous player turn, taking back the player's action and
+    // the enemy reply. Only during the player's turn; false if there is nothing to undo.
+    bool UndoLastTurn();
+
+    // Write every game to Saved/GameLogs for replay with -run=ChessReplay; otherwise only the last records are kept in memory
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Game Log")
+    bool bWriteGameLog = true;
+
+    // Event log of the current game; null before the game starts and after it ends
+    FChessGameLog* GetGameLog() { return GameLog.IsActive() ? &GameLog : nullptr; }
+
     UPROPERTY(EditDefaultsOnly, Category = "UI")
     TSubclassOf<UUserWidget> EndGameWidgetClass;
 
@@ -87,18 +189,87 @@ public:
     void EndGame(EGameResult Result);
 
 protected:
+    virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void Tick(float DeltaSeconds) override;
 
 private:
     void InitializeGame();
 
-    // Timer for enemy turn execution
-    FTimerHandle EnemyTurnTimerHandle;
-    void ProcessEnemyTurn();
-    int32 CurrentEnemyIndex = 0;
+    // Opens the log and records the starting position
+    void BeginGameLog();
+    void FlushGameLog() { GameLog.Flush(); }
+
+    FChessGameLog GameLog;
+    FDelegateHandle SystemErrorHandle;
+
+    // Per-game random stream; nothing in the game mode touches the global FMath RNG
+    FRandomStream RandomStream;
+    int32 ActiveSeed = 0;
+
+    // Owns the piece roster; registered with the board in InitializeGame
+    UPROPERTY()
+    class UChessWorldSubsystem* ChessWorld;
+
+    // Enemy phase: pacing delays count down in game time, computation runs in per-frame budgets
+    EEnemyPhaseStep EnemyPhaseStep = EEnemyPhaseStep::Idle;
+    float EnemyPhaseDelay = 0.0f;
+
+    // Runs steps until the frame budget is spent or a step has to wait
+    void AdvanceEnemyPhase(float DeltaSeconds);
+
+    // Runs one unit of work of the current step; false if it has to wait for a later frame
+    bool StepEnemyPhase(double Deadline);
+
+    // Snapshot the enemy phase decides on; EnemyPhasePieces[i] is the actor behind EnemyPhaseState.Pieces[i]
+    FChessGameState EnemyPhaseState;
+    TArray<TWeakObjectPtr<class AChessPieceBase>> EnemyPhasePieces;
 
-    void HighlightEnemyAttackRange(class AChessPieceBase* Enemy);
+    // Greedy choice on EnemyPhaseState, scored a batch at a time
+    FChessGreedyEnemyChooser GreedyChooser;
+
+    // Chosen action, PieceIndex INDEX_NONE if no enemy can act
+    FChessEnemyAction EnemyPhaseAction;
+
+    // Plays the chosen enemy action (Enemy null if no enemy can act)
+    void ExecuteEnemyAction(class AChessPieceBase* Enemy, const FChessEnemyAction& Action);
+
+    // Runs FChessEnemySearch on a worker; the result comes back through OnEnemySearchComplete on the game thread
+    void StartEnemySearch(const FChessGameState& Snapshot);
+    void OnEnemySearchComplete(int32 SearchId, const FChessSearchResult& Result);
+
+    // Results from any other search are stale and dropped
+    int32 ActiveSearchId = 0;
+
+    // Full rebuild of the enemy attack map (used once the enemies have been spawned)
     void HighlightAllEnemyAttackRanges();
-    void ClearEnemyHighlights();
-    TArray<class AChessTile*> HighlightedEnemyTiles;
+
+    // Marks every enemy whose attack range covers the square (and any enemy now standing on it) dirty
+    void OnBoardSquareChanged(int32 X, int32 Y);
+
+    // Undo history: the state at the start of this player turn, and per-turn deltas back to earlier ones
+    FChessGameState UndoTurnState;
+    FChessUndoStack UndoHistory;
+    TArray<FChessUndoPiece> UndoPieces;
+    bool bHasUndoTurnState = false;
+
+    // Like CaptureRulesState, but indexed by RosterIndex so dead pieces keep their slot
+    void CaptureUndoState(FChessGameState& OutState);
+    void RecordUndoTurn();
+
+    // Moves, re-stats and respawns actors to match State
+    void RestoreUndoState(const FChessGameState& State);
+
+    class APowerUp* SpawnPowerUpAt(int32 X, int32 Y, EPowerUpType Type, int32 SuperModeMovesCount);
+
+    // Per-square count of enemies attacking it, one source slot per enemy. Weak, so an enemy
+    // destroyed without RemoveEnemy leaves a stale slot for the next refresh to free.
+    FChessAttackMap EnemyAttackMap;
+    TMap<TWeakObjectPtr<class AChessPieceBase>, int32> EnemyAttackSlots;
+    TArray<TWeakObjectPtr<class AChessPieceBase>> EnemyAttackSlotOwners;
+    TSet<int32> DirtyAttackSlots;
+
+    // Squares currently drawn with the attack highlight
+    FChessBitboard EnemyHighlightedSquares;
 };
\ No newline at end of file